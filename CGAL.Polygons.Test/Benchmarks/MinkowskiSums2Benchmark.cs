@@ -0,0 +1,94 @@
+﻿using System;
+using System.Diagnostics;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+
+using Common.Core.LinearAlgebra;
+using CGAL.Polygons;
+
+namespace CGAL.Polygons.Test.Benchmarks
+{
+    [TestClass]
+    public class MinkowskiSums2Benchmark
+    {
+
+        private static readonly MINKOWSKI_STRATEGY[] STRATEGIES = new MINKOWSKI_STRATEGY[]
+        {
+            MINKOWSKI_STRATEGY.CONVEX,
+            MINKOWSKI_STRATEGY.REDUCED_CONVOLUTION,
+            MINKOWSKI_STRATEGY.SSAB,
+            MINKOWSKI_STRATEGY.TRIANGULATION,
+            MINKOWSKI_STRATEGY.OPTIMAL
+        };
+
+        [TestMethod, TestCategory("Benchmark")]
+        public void StrategySelection()
+        {
+            Console.WriteLine("case, vertices A, vertices B, auto, convex ms, reduced convolution ms, ssab ms, triangulation ms, optimal ms");
+
+            for (int n = 16; n <= 4096; n *= 4)
+                Run("convex", CreatePolygon2.FromCircle(new Vector2f(0), 10, n), CreatePolygon2.FromCircle(new Vector2f(0), 1, n));
+
+            for (int n = 16; n <= 4096; n *= 4)
+                Run("one reflex", CreateNotch(n), CreatePolygon2.FromCircle(new Vector2f(0), 1, 16));
+
+            for (int points = 4; points <= 64; points *= 2)
+                Run("star", CreateStar(points), CreatePolygon2.FromCircle(new Vector2f(0), 1, 16));
+
+            for (int points = 4; points <= 16; points *= 2)
+                Run("star star", CreateStar(points), CreateStar(points));
+        }
+
+        private static void Run(string name, Polygon2f A, Polygon2f B)
+        {
+            MINKOWSKI_STRATEGY chosen;
+            MinkowskiSums2.ComputeSum(A, B, MINKOWSKI_STRATEGY.AUTO, out chosen);
+
+            string line = string.Format("{0}, {1}, {2}, {3}", name, A.VerticesCount, B.VerticesCount, chosen);
+
+            foreach (MINKOWSKI_STRATEGY strategy in STRATEGIES)
+            {
+                //Optimal decomposition is O(n^4) so is only timed on small inputs.
+                bool skip = strategy == MINKOWSKI_STRATEGY.OPTIMAL && Math.Max(A.VerticesCount, B.VerticesCount) > 256;
+                skip |= strategy == MINKOWSKI_STRATEGY.CONVEX && !(A.IsConvex && B.IsConvex);
+
+                if (skip)
+                {
+                    line += ", -";
+                    continue;
+                }
+
+                MINKOWSKI_STRATEGY used;
+                Stopwatch watch = Stopwatch.StartNew();
+                MinkowskiSums2.ComputeSum(A, B, strategy, out used);
+                line += string.Format(", {0:F2}", watch.Elapsed.TotalMilliseconds);
+            }
+
+            Console.WriteLine(line);
+        }
+
+        //A circle with one notch cut into it.
+        private static Polygon2f CreateNotch(int segments)
+        {
+            Polygon2f polygon = CreatePolygon2.FromCircle(new Vector2f(0), 10, segments);
+            polygon.Positions[0] = new Vector2f(5, 0);
+            polygon.CalculatePolygon();
+            return polygon;
+        }
+
+        private static Polygon2f CreateStar(int points)
+        {
+            Polygon2f polygon = new Polygon2f(points * 2);
+
+            for (int i = 0; i < points * 2; i++)
+            {
+                double angle = Math.PI * i / points;
+                float radius = (i % 2 == 0) ? 10 : 4;
+                polygon.Positions[i] = new Vector2f(radius * (float)Math.Cos(angle), radius * (float)Math.Sin(angle));
+            }
+
+            polygon.CalculatePolygon();
+            return polygon;
+        }
+
+    }
+}
@@ -0,0 +1,58 @@
+﻿using System;
+using System.Diagnostics;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+
+using Common.Core.LinearAlgebra;
+using CGAL.Polygons;
+
+namespace CGAL.Polygons.Test.Benchmarks
+{
+    [TestClass]
+    public class PolygonIntersection2Benchmark
+    {
+
+        private const int NUM_POINTS = 100000;
+
+        [TestMethod, TestCategory("Benchmark")]
+        public void EdgeGridCrossover()
+        {
+            Random rnd = new Random(0);
+            Vector2f[] points = new Vector2f[NUM_POINTS];
+            for (int i = 0; i < points.Length; i++)
+                points[i] = new Vector2f((float)rnd.NextDouble() * 24 - 12, (float)rnd.NextDouble() * 24 - 12);
+
+            Console.WriteLine("edges, crossing test ms, edge grid ms");
+
+            for (int numEdges = 16; numEdges <= 524288; numEdges *= 2)
+            {
+                Polygon2f polygon = CreatePolygon2.FromCircle(new Vector2f(0), 10, numEdges);
+                PolygonIntersection2.PushPolygon(polygon);
+
+                PolygonIntersection2.SetEdgeGridThreshold(int.MaxValue);
+                double crossing = Time(points);
+
+                PolygonIntersection2.SetEdgeGridThreshold(0);
+                double grid = Time(points);
+
+                Console.WriteLine("{0}, {1:F2}, {2:F2}", numEdges, crossing, grid);
+
+                PolygonIntersection2.PopAll();
+            }
+
+            PolygonIntersection2.SetEdgeGridThreshold(-1);
+        }
+
+        private static double Time(Vector2f[] points)
+        {
+            //First call includes building the index.
+            PolygonIntersection2.ContainsPoint(points[0]);
+
+            Stopwatch watch = Stopwatch.StartNew();
+            PolygonIntersection2.FindContainingPolygons(points);
+            watch.Stop();
+
+            return watch.Elapsed.TotalMilliseconds;
+        }
+
+    }
+}
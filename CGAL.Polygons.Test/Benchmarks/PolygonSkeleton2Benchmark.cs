@@ -0,0 +1,105 @@
+﻿using System;
+using System.Diagnostics;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+
+using Common.Core.LinearAlgebra;
+using CGAL.Polygons;
+
+namespace CGAL.Polygons.Test.Benchmarks
+{
+    [TestClass]
+    public class PolygonSkeleton2Benchmark
+    {
+
+        [TestMethod, TestCategory("Benchmark")]
+        public void ApproximateMedialAxis()
+        {
+            Console.WriteLine("vertices, exact ms, approximate ms, max error");
+
+            for (int numVertices = 256; numVertices <= 65536; numVertices *= 4)
+            {
+                Polygon2f polygon = CreateRectangle(numVertices);
+                float tolerance = 40.0f / numVertices;
+
+                Stopwatch watch = Stopwatch.StartNew();
+                Skeleton2f exact = PolygonSkeleton2.CreateInteriorSkeleton(polygon);
+                double exactTime = watch.Elapsed.TotalMilliseconds;
+
+                watch = Stopwatch.StartNew();
+                Skeleton2f axis = PolygonSkeleton2.CreateApproximateMedialAxis(polygon, tolerance);
+                double axisTime = watch.Elapsed.TotalMilliseconds;
+
+                Console.WriteLine("{0}, {1:F2}, {2:F2}, {3:F5}", numVertices, exactTime, axisTime, MaxError(axis, exact));
+            }
+        }
+
+        //A 16 by 4 rectangle with its sides split into many vertices. Being
+        //convex its straight skeleton is also its medial axis.
+        private static Polygon2f CreateRectangle(int numVertices)
+        {
+            Vector2f[] corners = new Vector2f[]
+            {
+                new Vector2f(-8, -2), new Vector2f(8, -2), new Vector2f(8, 2), new Vector2f(-8, 2)
+            };
+
+            float[] lengths = new float[] { 16, 4, 16, 4 };
+
+            Polygon2f polygon = new Polygon2f(numVertices);
+            int index = 0;
+
+            for (int i = 0; i < 4; i++)
+            {
+                int count = (int)(numVertices * lengths[i] / 40.0f);
+                if (i == 3) count = numVertices - index;
+
+                Vector2f a = corners[i];
+                Vector2f b = corners[(i + 1) % 4];
+
+                for (int j = 0; j < count; j++)
+                {
+                    float t = j / (float)count;
+                    polygon.Positions[index++] = new Vector2f(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t);
+                }
+            }
+
+            polygon.CalculatePolygon();
+
+            return polygon;
+        }
+
+        //Furthest any approximate axis vertex lies from the exact skeleton.
+        private static float MaxError(Skeleton2f axis, Skeleton2f exact)
+        {
+            float error = 0;
+
+            for (int i = 0; i < axis.Points.Length; i++)
+            {
+                float nearest = float.PositiveInfinity;
+
+                for (int j = 0; j < exact.Edges.Length; j++)
+                {
+                    Vector2f a = exact.Points[exact.Edges[j].i0];
+                    Vector2f b = exact.Points[exact.Edges[j].i1];
+                    nearest = Math.Min(nearest, SegmentDistance(axis.Points[i], a, b));
+                }
+
+                error = Math.Max(error, nearest);
+            }
+
+            return error;
+        }
+
+        private static float SegmentDistance(Vector2f p, Vector2f a, Vector2f b)
+        {
+            float abx = b.x - a.x, aby = b.y - a.y;
+            float len = abx * abx + aby * aby;
+            float t = (len > 0) ? ((p.x - a.x) * abx + (p.y - a.y) * aby) / len : 0;
+            t = Math.Max(0, Math.Min(1, t));
+
+            float dx = a.x + abx * t - p.x;
+            float dy = a.y + aby * t - p.y;
+            return (float)Math.Sqrt(dx * dx + dy * dy);
+        }
+
+    }
+}
@@ -1,4 +1,5 @@
 ﻿using System;
+using System.Collections.Generic;
 using Microsoft.VisualStudio.TestTools.UnitTesting;
 
 using Common.Core.LinearAlgebra;
@@ -44,5 +45,132 @@ namespace CGAL.Polygons.Test
             CollectionAssert.AreEqual(points, sum.Positions);
 
         }
+
+        [TestMethod]
+        public void ComputeSumStrategies()
+        {
+            Polygon2f box = CreatePolygon2.FromBox(new Vector2f(-1), new Vector2f(1));
+            Polygon2f circle = CreatePolygon2.FromCircle(new Vector2f(0), 1, 16);
+
+            Vector2f[] pointsL = new Vector2f[]
+            {
+                new Vector2f(0, 0),
+                new Vector2f(4, 0),
+                new Vector2f(4, 1),
+                new Vector2f(1, 1),
+                new Vector2f(1, 4),
+                new Vector2f(0, 4)
+            };
+
+            Polygon2f L = new Polygon2f(pointsL);
+
+            MINKOWSKI_STRATEGY used;
+            Polygon2f convex = MinkowskiSums2.ComputeSum(box, circle, MINKOWSKI_STRATEGY.AUTO, out used);
+            Assert.AreEqual(MINKOWSKI_STRATEGY.CONVEX, used);
+
+            Polygon2f reference = MinkowskiSums2.ComputeSum(box, circle, MINKOWSKI_STRATEGY.REDUCED_CONVOLUTION, out used);
+            Assert.AreEqual(MINKOWSKI_STRATEGY.REDUCED_CONVOLUTION, used);
+            Assert.AreEqual(reference.Area, convex.Area, 1e-4f);
+
+            Polygon2f auto = MinkowskiSums2.ComputeSum(L, box, MINKOWSKI_STRATEGY.AUTO, out used);
+            Assert.AreEqual(MINKOWSKI_STRATEGY.OPTIMAL, used);
+
+            MINKOWSKI_STRATEGY[] strategies = new MINKOWSKI_STRATEGY[]
+            {
+                MINKOWSKI_STRATEGY.REDUCED_CONVOLUTION,
+                MINKOWSKI_STRATEGY.SSAB,
+                MINKOWSKI_STRATEGY.TRIANGULATION,
+                MINKOWSKI_STRATEGY.OPTIMAL
+            };
+
+            foreach (MINKOWSKI_STRATEGY strategy in strategies)
+            {
+                Polygon2f sum = MinkowskiSums2.ComputeSum(L, box, strategy, out used);
+                Assert.AreEqual(strategy, used);
+                Assert.AreEqual(auto.Area, sum.Area, 1e-4f);
+            }
+
+            MinkowskiSums2.ComputeSum(L, box, MINKOWSKI_STRATEGY.CONVEX, out used);
+            Assert.AreNotEqual(MINKOWSKI_STRATEGY.CONVEX, used);
+        }
+
+        [TestMethod]
+        public void ComputeSums()
+        {
+            Polygon2f B = CreatePolygon2.FromBox(new Vector2f(-0.5f), new Vector2f(0.5f));
+
+            Polygon2f box = CreatePolygon2.FromBox(new Vector2f(0), new Vector2f(2));
+
+            Polygon2f ring = CreatePolygon2.FromBox(new Vector2f(10), new Vector2f(16));
+            Polygon2f hole = CreatePolygon2.FromBox(new Vector2f(12), new Vector2f(14));
+            hole.MakeCW();
+            ring.AddHole(hole);
+            ring.CalculatePolygon();
+
+            List<Polygon2f> obstacles = new List<Polygon2f>() { box, ring };
+
+            List<Polygon2f>[] sums = MinkowskiSums2.ComputeSums(obstacles, B);
+
+            Assert.AreEqual(2, sums.Length);
+            Assert.AreEqual(1, sums[0].Count);
+            Assert.AreEqual(1, sums[1].Count);
+            Assert.AreEqual(9, sums[0][0].Area, 1e-4f);
+            Assert.AreEqual(1, sums[1][0].HoleCount);
+            Assert.AreEqual(48, sums[1][0].Area, 1e-4f);
+
+            List<Polygon2f> union = MinkowskiSums2.ComputeSumsUnion(obstacles, B);
+            Assert.AreEqual(2, union.Count);
+
+            obstacles.Add(CreatePolygon2.FromBox(new Vector2f(2, 0), new Vector2f(4, 2)));
+            union = MinkowskiSums2.ComputeSumsUnion(obstacles, B);
+            Assert.AreEqual(2, union.Count);
+
+            Vector2f[] pointsL = new Vector2f[]
+            {
+                new Vector2f(0, 0),
+                new Vector2f(2, 0),
+                new Vector2f(2, 1),
+                new Vector2f(1, 1),
+                new Vector2f(1, 2),
+                new Vector2f(0, 2)
+            };
+
+            Vector2f[] reflectedL = new Vector2f[pointsL.Length];
+            for (int i = 0; i < pointsL.Length; i++)
+                reflectedL[i] = new Vector2f(-pointsL[i].x, -pointsL[i].y);
+
+            Polygon2f L = new Polygon2f(pointsL);
+            Polygon2f expected = MinkowskiSums2.ComputeSum(box, new Polygon2f(reflectedL));
+
+            sums = MinkowskiSums2.ComputeSums(new List<Polygon2f>() { box }, L, true);
+            Assert.AreEqual(1, sums[0].Count);
+            Assert.AreEqual(expected.Area, sums[0][0].Area, 1e-4f);
+        }
+
+        [TestMethod]
+        public void Offset()
+        {
+            Polygon2f box = CreatePolygon2.FromBox(new Vector2f(0), new Vector2f(2));
+
+            List<Polygon2f> grown = MinkowskiSums2.Offset(box, 1, 0.001f);
+            Assert.AreEqual(1, grown.Count);
+            Assert.AreEqual(12 + Math.PI, grown[0].Area, 0.02);
+
+            List<Polygon2f> shrunk = MinkowskiSums2.Offset(box, -0.5f, 0.001f);
+            Assert.AreEqual(1, shrunk.Count);
+            Assert.AreEqual(1, shrunk[0].Area, 1e-3);
+
+            Polygon2f ring = CreatePolygon2.FromBox(new Vector2f(0), new Vector2f(6));
+            Polygon2f hole = CreatePolygon2.FromBox(new Vector2f(2), new Vector2f(4));
+            hole.MakeCW();
+            ring.AddHole(hole);
+            ring.CalculatePolygon();
+
+            List<Polygon2f>[] offsets = MinkowskiSums2.Offset(new List<Polygon2f>() { box, ring }, -0.5f, 0.001f);
+            Assert.AreEqual(2, offsets.Length);
+            Assert.AreEqual(1, offsets[1].Count);
+            Assert.AreEqual(1, offsets[1][0].HoleCount);
+            Assert.AreEqual(17 - Math.PI * 0.25, offsets[1][0].Area, 0.02);
+        }
     }
 }
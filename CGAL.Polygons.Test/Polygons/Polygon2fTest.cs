@@ -4,6 +4,7 @@ using Microsoft.VisualStudio.TestTools.UnitTesting;
 
 using Common.Core.LinearAlgebra;
 using CGAL.Polygons;
+using CGAL.Polygons.Descriptors;
 
 namespace CGAL.Polygons.Test
 {
@@ -43,5 +44,133 @@ namespace CGAL.Polygons.Test
             Assert.IsTrue(polygon.Orientation == ORIENTATION.CLOCKWISE);
         }
 
+        [TestMethod]
+        public void BatchProperties()
+        {
+            Polygon2f box = CreatePolygon2.FromBox(new Vector2f(0), new Vector2f(4));
+            Polygon2f hole = CreatePolygon2.FromBox(new Vector2f(0.5f), new Vector2f(1.5f));
+            hole.MakeCW();
+            box.AddHole(hole);
+            box.CalculatePolygon();
+
+            Polygon2f bowtie = new Polygon2f(4);
+            bowtie.Positions[0] = new Vector2f(0, 0);
+            bowtie.Positions[1] = new Vector2f(2, 2);
+            bowtie.Positions[2] = new Vector2f(2, 0);
+            bowtie.Positions[3] = new Vector2f(0, 2);
+
+            Vector2f[] pointsL = new Vector2f[]
+            {
+                new Vector2f(0, 0),
+                new Vector2f(2, 0),
+                new Vector2f(2, 1),
+                new Vector2f(1, 1),
+                new Vector2f(1, 2),
+                new Vector2f(0, 2)
+            };
+
+            List<Polygon2f> polygons = new List<Polygon2f>()
+            {
+                box,
+                bowtie,
+                new Polygon2f(pointsL)
+            };
+
+            PolygonProperties[] properties = Polygon2f.BatchProperties(polygons);
+
+            Assert.AreEqual(3, properties.Length);
+            Assert.IsFalse(properties[0].SimpleChecked);
+            Assert.AreEqual(15, properties[0].Area, 1e-6);
+            Assert.AreEqual(20, properties[0].Perimeter, 1e-6);
+            Assert.AreEqual((16 * 2 - 1) / 15.0, properties[0].CentroidX, 1e-6);
+            Assert.IsFalse(properties[0].IsConvex);
+            Assert.AreEqual(ORIENTATION.COUNTERCLOCKWISE, properties[0].Orientation);
+            Assert.AreEqual(4, properties[0].XMax);
+
+            Assert.AreEqual(3, properties[2].Area, 1e-6);
+            Assert.AreEqual(8, properties[2].Perimeter, 1e-6);
+            Assert.AreEqual(5 / 6.0, properties[2].CentroidX, 1e-6);
+            Assert.AreEqual(5 / 6.0, properties[2].CentroidY, 1e-6);
+
+            properties = Polygon2f.BatchProperties(polygons, true);
+
+            Assert.IsTrue(properties[0].IsSimple);
+            Assert.IsFalse(properties[1].IsSimple);
+            Assert.AreEqual(ORIENTATION.COLLINEAR, properties[1].Orientation);
+            Assert.IsTrue(properties[2].IsSimple);
+            Assert.IsFalse(properties[2].IsConvex);
+        }
+
+        [TestMethod]
+        public void FromRings()
+        {
+            Polygon2f outer = CreatePolygon2.FromBox(new Vector2f(0), new Vector2f(10));
+            outer.MakeCW();
+
+            List<Polygon2f> rings = new List<Polygon2f>()
+            {
+                CreatePolygon2.FromBox(new Vector2f(2), new Vector2f(8)),
+                outer,
+                CreatePolygon2.FromBox(new Vector2f(3), new Vector2f(5)),
+                CreatePolygon2.FromBox(new Vector2f(20, 0), new Vector2f(30, 10))
+            };
+
+            int[] depths, parents;
+            List<Polygon2f> polygons = Polygon2f.FromRings(rings, out depths, out parents);
+
+            CollectionAssert.AreEqual(new int[] { 1, 0, 2, 0 }, depths);
+            CollectionAssert.AreEqual(new int[] { 1, -1, 0, -1 }, parents);
+
+            Assert.AreEqual(3, polygons.Count);
+
+            Assert.AreEqual(1, polygons[0].HoleCount);
+            Assert.IsTrue(polygons[0].IsCCW);
+            Assert.IsTrue(polygons[0].Holes[0].IsCW);
+            Assert.AreEqual(100 - 36, polygons[0].Area, 1e-4f);
+
+            Assert.AreEqual(0, polygons[1].HoleCount);
+            Assert.AreEqual(4, polygons[1].Area, 1e-4f);
+
+            Assert.AreEqual(0, polygons[2].HoleCount);
+            Assert.AreEqual(100, polygons[2].Area, 1e-4f);
+        }
+
+        [TestMethod]
+        public void FromRingsSharedX()
+        {
+            Vector2f[] pointsOuter = new Vector2f[]
+            {
+                new Vector2f(0, 0),
+                new Vector2f(4, 0),
+                new Vector2f(8, 0),
+                new Vector2f(8, 8),
+                new Vector2f(0, 8)
+            };
+
+            Vector2f[] pointsHole = new Vector2f[]
+            {
+                new Vector2f(4, 4),
+                new Vector2f(5, 6),
+                new Vector2f(6, 4)
+            };
+
+            List<Polygon2f> rings = new List<Polygon2f>()
+            {
+                new Polygon2f(pointsOuter),
+                new Polygon2f(pointsHole)
+            };
+
+            int[] depths, parents;
+            List<Polygon2f> polygons = Polygon2f.FromRings(rings, out depths, out parents);
+
+            CollectionAssert.AreEqual(new int[] { 0, 1 }, depths);
+            CollectionAssert.AreEqual(new int[] { -1, 0 }, parents);
+
+            Assert.AreEqual(1, polygons.Count);
+            Assert.AreEqual(1, polygons[0].HoleCount);
+            Assert.IsTrue(polygons[0].Holes[0].IsCW);
+            Assert.AreEqual(64 - 2, polygons[0].Area, 1e-4f);
+        }
+
     }
 }
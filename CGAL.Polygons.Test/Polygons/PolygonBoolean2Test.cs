@@ -4,6 +4,7 @@ using Microsoft.VisualStudio.TestTools.UnitTesting;
 
 using Common.Core.LinearAlgebra;
 using CGAL.Polygons;
+using CGAL.Polygons.Descriptors;
 
 namespace CGAL.Polygons.Test
 {
@@ -87,5 +88,177 @@ namespace CGAL.Polygons.Test
             Assert.AreEqual(1, list[0].HoleCount);
             Assert.AreEqual(6, list[0].Area);
         }
+
+        [TestMethod]
+        public void BatchDoIntersect()
+        {
+
+            List<Polygon2f> A = new List<Polygon2f>();
+            A.Add(CreatePolygon2.FromBox(new Vector2f(-1), new Vector2f(1)));
+            A.Add(CreatePolygon2.FromBox(new Vector2f(10), new Vector2f(11)));
+
+            List<Polygon2f> B = new List<Polygon2f>();
+            B.Add(CreatePolygon2.FromBox(new Vector2f(0), new Vector2f(2)));
+            B.Add(CreatePolygon2.FromBox(new Vector2f(-1, 1), new Vector2f(1, 3)));
+            B.Add(CreatePolygon2.FromBox(new Vector2f(-3, -1), new Vector2f(-2, 1)));
+            B.Add(CreatePolygon2.FromBox(new Vector2f(10.5f), new Vector2f(12)));
+
+            List<PolygonPair> pairs = PolygonBoolean2.BatchDoIntersect(A, B, true);
+
+            Assert.AreEqual(2, pairs.Count);
+
+            Assert.AreEqual(0, pairs[0].A);
+            Assert.AreEqual(0, pairs[0].B);
+            Assert.AreEqual(1.0, pairs[0].Area, 1e-6);
+
+            Assert.AreEqual(1, pairs[1].A);
+            Assert.AreEqual(3, pairs[1].B);
+            Assert.AreEqual(0.25, pairs[1].Area, 1e-6);
+        }
+
+        [TestMethod]
+        public void ClipToGrid()
+        {
+            Polygon2f box = CreatePolygon2.FromBox(new Vector2f(1), new Vector2f(3));
+
+            Polygon2f ring = CreatePolygon2.FromBox(new Vector2f(4, 0), new Vector2f(8, 4));
+            Polygon2f hole = CreatePolygon2.FromBox(new Vector2f(5, 1), new Vector2f(7, 3));
+            hole.MakeCW();
+            ring.AddHole(hole);
+            ring.CalculatePolygon();
+
+            Vector2f[] pointsU = new Vector2f[]
+            {
+                new Vector2f(0, 4),
+                new Vector2f(1.8f, 4),
+                new Vector2f(1.8f, 7),
+                new Vector2f(1.2f, 7),
+                new Vector2f(1.2f, 5),
+                new Vector2f(0.6f, 5),
+                new Vector2f(0.6f, 7),
+                new Vector2f(0, 7)
+            };
+
+            List<Polygon2f> polygons = new List<Polygon2f>() { box, ring, new Polygon2f(pointsU) };
+
+            List<int>[] sources;
+            List<Polygon2f>[] tiles = PolygonBoolean2.ClipToGrid(polygons, new Vector2f(0), new Vector2f(2), 4, 4, out sources);
+
+            Assert.AreEqual(16, tiles.Length);
+
+            //The box covers one unit of each of the four tiles at the origin.
+            for (int i = 0; i < 16; i++)
+            {
+                if (i == 0 || i == 1 || i == 4 || i == 5)
+                {
+                    Assert.AreEqual(1, tiles[i].Count);
+                    Assert.AreEqual(1, tiles[i][0].Area, 1e-4f);
+                    Assert.AreEqual(0, sources[i][0]);
+                }
+            }
+
+            //The hole crosses the tiles of the ring so those fall back to the exact clip.
+            float ringArea = 0;
+            for (int i = 0; i < 16; i++)
+            {
+                for (int j = 0; j < tiles[i].Count; j++)
+                {
+                    if (sources[i][j] == 1) ringArea += tiles[i][j].Area;
+                }
+            }
+
+            Assert.AreEqual(12, ringArea, 1e-4f);
+
+            //The top of the u is cut into its two arms, which the exact clip handles.
+            Assert.AreEqual(2, tiles[12].Count);
+            Assert.AreEqual(2, sources[12][0]);
+            Assert.AreEqual(2, sources[12][1]);
+            Assert.AreEqual(1.2f, tiles[12][0].Area + tiles[12][1].Area, 1e-4f);
+        }
+
+        [TestMethod]
+        public void ClipToGridHoles()
+        {
+            Polygon2f polygon = CreatePolygon2.FromBox(new Vector2f(0), new Vector2f(6));
+
+            Polygon2f covering = CreatePolygon2.FromBox(new Vector2f(1.5f), new Vector2f(4.5f));
+            covering.MakeCW();
+            polygon.AddHole(covering);
+
+            Polygon2f inside = CreatePolygon2.FromBox(new Vector2f(0.5f, 4.75f), new Vector2f(1.25f, 5.5f));
+            inside.MakeCW();
+            polygon.AddHole(inside);
+
+            polygon.CalculatePolygon();
+
+            List<Polygon2f>[] tiles = PolygonBoolean2.ClipToGrid(new List<Polygon2f>() { polygon }, new Vector2f(0), new Vector2f(2), 3, 3);
+
+            //The middle tile is inside the first hole.
+            Assert.AreEqual(0, tiles[4].Count);
+
+            Assert.AreEqual(1, tiles[6].Count);
+            Assert.AreEqual(1, tiles[6][0].HoleCount);
+
+            float area = 0;
+            for (int i = 0; i < tiles.Length; i++)
+            {
+                for (int j = 0; j < tiles[i].Count; j++)
+                    area += tiles[i][j].Area;
+            }
+
+            Assert.AreEqual(36 - 9 - 0.5625f, area, 1e-4f);
+        }
+
+        [TestMethod]
+        public void ClipToGridOnTileLines()
+        {
+            //The apex lies on the line between the two tiles.
+            Vector2f[] triangle = new Vector2f[]
+            {
+                new Vector2f(0, 0),
+                new Vector2f(4, 0),
+                new Vector2f(2, 2)
+            };
+
+            List<Polygon2f>[] halves = PolygonBoolean2.ClipToGrid(new List<Polygon2f>() { new Polygon2f(triangle) }, new Vector2f(0), new Vector2f(2), 2, 1);
+
+            for (int i = 0; i < 2; i++)
+            {
+                Assert.AreEqual(1, halves[i].Count);
+                Assert.AreEqual(3, halves[i][0].VerticesCount);
+                Assert.IsTrue(halves[i][0].IsSimple);
+                Assert.AreEqual(2, halves[i][0].Area, 1e-4f);
+            }
+
+            //A c shape spanning the grid is one piece in every tile it covers.
+            Vector2f[] pointsC = new Vector2f[]
+            {
+                new Vector2f(0, 0),
+                new Vector2f(6, 0),
+                new Vector2f(6, 1),
+                new Vector2f(1, 1),
+                new Vector2f(1, 5),
+                new Vector2f(6, 5),
+                new Vector2f(6, 6),
+                new Vector2f(0, 6)
+            };
+
+            List<Polygon2f>[] tiles = PolygonBoolean2.ClipToGrid(new List<Polygon2f>() { new Polygon2f(pointsC) }, new Vector2f(0), new Vector2f(2), 3, 3);
+
+            float area = 0;
+            for (int i = 0; i < tiles.Length; i++)
+            {
+                Assert.AreEqual((i == 4 || i == 5) ? 0 : 1, tiles[i].Count);
+
+                foreach (Polygon2f piece in tiles[i])
+                {
+                    Assert.IsTrue(piece.IsSimple);
+                    area += piece.Area;
+                }
+            }
+
+            Assert.AreEqual(16, area, 1e-4f);
+        }
+
     }
 }
@@ -0,0 +1,58 @@
+﻿using System;
+using System.Collections.Generic;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+
+using Common.Core.LinearAlgebra;
+using CGAL.Polygons;
+
+namespace CGAL.Polygons.Test
+{
+    [TestClass]
+    public class PolygonDistance2Test
+    {
+        [TestMethod]
+        public void SignedDistanceField()
+        {
+
+            Polygon2f polygon = CreatePolygon2.FromBox(new Vector2f(-2), new Vector2f(2));
+            Polygon2f hole = CreatePolygon2.FromBox(new Vector2f(-1), new Vector2f(1));
+            hole.MakeCW();
+            polygon.AddHole(hole);
+
+            List<Polygon2f> polygons = new List<Polygon2f>();
+            polygons.Add(polygon);
+
+            //Cell centers at -3.75, -3.25 ... 3.75 on both axes.
+            int size = 16;
+            float[] field = PolygonDistance2.SignedDistanceField(polygons, new Vector2f(-4), 0.5f, size, size);
+
+            Assert.AreEqual(size * size, field.Length);
+
+            for (int y = 0; y < size; y++)
+            {
+                for (int x = 0; x < size; x++)
+                {
+                    Vector2f p = new Vector2f(-3.75f + x * 0.5f, -3.75f + y * 0.5f);
+                    float expected = BoxDistance(p, 2);
+
+                    float hd = BoxDistance(p, 1);
+                    if (hd < 0) expected = -hd;
+                    else if (expected < 0) expected = Math.Max(expected, -hd);
+
+                    Assert.AreEqual(expected, field[x + y * size], 1e-4f);
+                }
+            }
+        }
+
+        private static float BoxDistance(Vector2f p, float half)
+        {
+            float dx = Math.Abs(p.x) - half;
+            float dy = Math.Abs(p.y) - half;
+
+            float ox = Math.Max(dx, 0), oy = Math.Max(dy, 0);
+            float outside = (float)Math.Sqrt(ox * ox + oy * oy);
+
+            return outside + Math.Min(Math.Max(dx, dy), 0);
+        }
+    }
+}
\ No newline at end of file
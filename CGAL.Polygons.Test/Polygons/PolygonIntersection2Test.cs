@@ -3,6 +3,7 @@ using Microsoft.VisualStudio.TestTools.UnitTesting;
 
 using Common.Core.LinearAlgebra;
 using CGAL.Polygons;
+using CGAL.Polygons.Descriptors;
 
 namespace CGAL.Polygons.Test
 {
@@ -44,5 +45,173 @@ namespace CGAL.Polygons.Test
 
             PolygonIntersection2.PopPolygon();
         }
+
+        [TestMethod]
+        public void ContainsPointMany()
+        {
+
+            for (int y = 0; y < 10; y++)
+            {
+                for (int x = 0; x < 10; x++)
+                {
+                    Vector2f min = new Vector2f(x * 2, y * 2);
+                    Polygon2f polygon = CreatePolygon2.FromBox(min, min + new Vector2f(1));
+                    PolygonIntersection2.PushPolygon(polygon);
+                }
+            }
+
+            Assert.IsTrue(PolygonIntersection2.ContainsPoint(new Vector2f(0.5f, 0.5f)));
+            Assert.IsTrue(PolygonIntersection2.ContainsPoint(new Vector2f(18.5f, 18.5f)));
+            Assert.IsTrue(PolygonIntersection2.ContainsPoint(new Vector2f(6.5f, 12.5f)));
+
+            //between boxes
+            Assert.IsFalse(PolygonIntersection2.ContainsPoint(new Vector2f(1.5f, 1.5f)));
+            Assert.IsFalse(PolygonIntersection2.ContainsPoint(new Vector2f(7.5f, 12.5f)));
+
+            //outside all boxes
+            Assert.IsFalse(PolygonIntersection2.ContainsPoint(new Vector2f(-5, -5)));
+            Assert.IsFalse(PolygonIntersection2.ContainsPoint(new Vector2f(50, 50)));
+
+            PolygonIntersection2.PopPolygon();
+
+            //last box removed
+            Assert.IsFalse(PolygonIntersection2.ContainsPoint(new Vector2f(18.5f, 18.5f)));
+            Assert.IsTrue(PolygonIntersection2.ContainsPoint(new Vector2f(16.5f, 18.5f)));
+
+            PolygonIntersection2.PopAll();
+        }
+
+        [TestMethod]
+        public void FindContainingPolygons()
+        {
+
+            Polygon2f polygon = CreatePolygon2.FromBox(new Vector2f(-2), new Vector2f(2));
+            Polygon2f hole = CreatePolygon2.FromBox(new Vector2f(-1), new Vector2f(1));
+            hole.MakeCW();
+            polygon.AddHole(hole);
+
+            PolygonIntersection2.PushPolygon(polygon);
+            PolygonIntersection2.PushPolygon(CreatePolygon2.FromBox(new Vector2f(-0.5f), new Vector2f(0.5f)));
+            PolygonIntersection2.PushPolygon(CreatePolygon2.FromBox(new Vector2f(1.25f), new Vector2f(3)));
+
+            Vector2f[] points = new Vector2f[]
+            {
+                new Vector2f(1.5f, -1.5f),
+                new Vector2f(0, 0),
+                new Vector2f(0.75f, 0.75f),
+                new Vector2f(1.5f, 1.5f),
+                new Vector2f(2.5f, 2.5f),
+                new Vector2f(2, 0),
+                new Vector2f(1, 0),
+                new Vector2f(5, 5),
+                new Vector2f(-1.5f, 1.5f)
+            };
+
+            int[] indices = PolygonIntersection2.FindContainingPolygons(points);
+            CollectionAssert.AreEqual(new int[] { 0, 1, -1, 0, 2, -1, -1, -1, 0 }, indices);
+
+            byte[] mask = PolygonIntersection2.ContainsPointsMask(points);
+            Assert.AreEqual(2, mask.Length);
+            Assert.AreEqual(0x1B, mask[0]);
+            Assert.AreEqual(0x01, mask[1]);
+
+            PolygonIntersection2.PopAll();
+        }
+
+        [TestMethod]
+        public void ContainsPointLargePolygon()
+        {
+
+            Polygon2f polygon = CreatePolygon2.FromCircle(new Vector2f(0), 10, 4096);
+            Polygon2f hole = CreatePolygon2.FromCircle(new Vector2f(0), 5, 2048);
+            hole.MakeCW();
+            polygon.AddHole(hole);
+
+            PolygonIntersection2.PushPolygon(polygon);
+
+            Random rnd = new Random(0);
+            Vector2f[] points = new Vector2f[10000];
+            for (int i = 0; i < points.Length; i++)
+                points[i] = new Vector2f((float)rnd.NextDouble() * 24 - 12, (float)rnd.NextDouble() * 24 - 12);
+
+            PolygonIntersection2.SetEdgeGridThreshold(int.MaxValue);
+            int[] expected = PolygonIntersection2.FindContainingPolygons(points);
+
+            PolygonIntersection2.SetEdgeGridThreshold(0);
+            int[] indices = PolygonIntersection2.FindContainingPolygons(points);
+
+            CollectionAssert.AreEqual(expected, indices);
+
+            Assert.IsTrue(PolygonIntersection2.ContainsPoint(new Vector2f(7.5f, 0)));
+            Assert.IsFalse(PolygonIntersection2.ContainsPoint(new Vector2f(0, 0)));
+            Assert.IsFalse(PolygonIntersection2.ContainsPoint(polygon.Positions[10]));
+            Assert.IsFalse(PolygonIntersection2.ContainsPoint(hole.Positions[10]));
+
+            PolygonIntersection2.SetEdgeGridThreshold(-1);
+            PolygonIntersection2.PopAll();
+        }
+
+        [TestMethod]
+        public void Raycast()
+        {
+
+            Polygon2f polygon = CreatePolygon2.FromBox(new Vector2f(-2), new Vector2f(2));
+            Polygon2f hole = CreatePolygon2.FromBox(new Vector2f(-1), new Vector2f(1));
+            hole.MakeCW();
+            polygon.AddHole(hole);
+
+            PolygonIntersection2.PushPolygon(polygon);
+            PolygonIntersection2.PushPolygon(CreatePolygon2.FromBox(new Vector2f(3, -1), new Vector2f(4, 1)));
+
+            Vector2f[] origins = new Vector2f[]
+            {
+                new Vector2f(-3, 0),
+                new Vector2f(0, 0),
+                new Vector2f(0, 5),
+                new Vector2f(-3, 0),
+                new Vector2f(2.5f, 0)
+            };
+
+            Vector2f[] directions = new Vector2f[]
+            {
+                new Vector2f(1, 0),
+                new Vector2f(2, 0),
+                new Vector2f(1, 0),
+                new Vector2f(-1, 0),
+                new Vector2f(1, 0)
+            };
+
+            RayHit[] hits = PolygonIntersection2.Raycast(origins, directions, 100);
+
+            Assert.AreEqual(0, hits[0].Polygon);
+            Assert.AreEqual(3, hits[0].Edge);
+            Assert.AreEqual(1.0f, hits[0].Distance, 1e-5f);
+
+            Assert.AreEqual(0, hits[1].Polygon);
+            Assert.IsTrue(hits[1].Edge >= 4);
+            Assert.AreEqual(1.0f, hits[1].Distance, 1e-5f);
+
+            Assert.IsFalse(hits[2].Hit);
+            Assert.IsFalse(hits[3].Hit);
+
+            Assert.AreEqual(1, hits[4].Polygon);
+            Assert.AreEqual(3, hits[4].Edge);
+            Assert.AreEqual(0.5f, hits[4].Distance, 1e-5f);
+
+            hits = PolygonIntersection2.Raycast(origins, directions, 0.25f);
+            Assert.IsFalse(hits[0].Hit);
+
+            Vector2f[] starts = new Vector2f[] { new Vector2f(-3, 3), new Vector2f(-3, 0), new Vector2f(2.5f, 0) };
+            Vector2f[] ends = new Vector2f[] { new Vector2f(3, 3), new Vector2f(-2.5f, 0), new Vector2f(5, 0) };
+
+            hits = PolygonIntersection2.SegmentHits(starts, ends);
+
+            Assert.IsFalse(hits[0].Hit);
+            Assert.IsFalse(hits[1].Hit);
+            Assert.AreEqual(1, hits[2].Polygon);
+            Assert.AreEqual(0.5f, hits[2].Distance, 1e-5f);
+
+            PolygonIntersection2.PopAll();
+        }
     }
 }
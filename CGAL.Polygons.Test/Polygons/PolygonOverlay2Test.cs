@@ -0,0 +1,108 @@
+﻿using System;
+using System.Collections.Generic;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+
+using Common.Core.LinearAlgebra;
+using CGAL.Polygons;
+using CGAL.Polygons.Descriptors;
+
+namespace CGAL.Polygons.Test
+{
+    [TestClass]
+    public class PolygonOverlay2Test
+    {
+        [TestMethod]
+        public void Overlay()
+        {
+            List<Polygon2f> A = new List<Polygon2f>()
+            {
+                CreatePolygon2.FromBox(new Vector2f(0, 0), new Vector2f(2, 2)),
+                CreatePolygon2.FromBox(new Vector2f(2, 0), new Vector2f(4, 2))
+            };
+
+            List<Polygon2f> B = new List<Polygon2f>()
+            {
+                CreatePolygon2.FromBox(new Vector2f(1, 1), new Vector2f(3, 3))
+            };
+
+            List<PolygonPair> sources;
+            List<Polygon2f> faces = PolygonOverlay2.Overlay(A, B, out sources);
+
+            Assert.AreEqual(5, faces.Count);
+            Assert.AreEqual(5, sources.Count);
+
+            double total = 0;
+            for (int i = 0; i < faces.Count; i++)
+            {
+                Assert.AreEqual(sources[i].Area, faces[i].Area, 1e-4);
+                total += sources[i].Area;
+
+                if (sources[i].A != -1 && sources[i].B != -1)
+                    Assert.AreEqual(1, sources[i].Area, 1e-4);
+                else if (sources[i].A != -1)
+                    Assert.AreEqual(3, sources[i].Area, 1e-4);
+                else
+                    Assert.AreEqual(2, sources[i].Area, 1e-4);
+            }
+
+            Assert.AreEqual(10, total, 1e-4);
+
+            faces = PolygonOverlay2.Overlay(A, B, out sources, true);
+
+            Assert.AreEqual(2, faces.Count);
+            sources.Sort((p0, p1) => p0.A.CompareTo(p1.A));
+
+            Assert.AreEqual(0, sources[0].A);
+            Assert.AreEqual(0, sources[0].B);
+            Assert.AreEqual(1, sources[1].A);
+            Assert.AreEqual(0, sources[1].B);
+        }
+
+        [TestMethod]
+        public void OverlayWithHoles()
+        {
+            Polygon2f ring = CreatePolygon2.FromBox(new Vector2f(0), new Vector2f(6));
+            Polygon2f hole = CreatePolygon2.FromBox(new Vector2f(2), new Vector2f(4));
+            hole.MakeCW();
+            ring.AddHole(hole);
+            ring.CalculatePolygon();
+
+            List<Polygon2f> A = new List<Polygon2f>() { ring };
+            List<Polygon2f> B = new List<Polygon2f>()
+            {
+                CreatePolygon2.FromBox(new Vector2f(2.5f), new Vector2f(3.5f)),
+                CreatePolygon2.FromBox(new Vector2f(5, 0), new Vector2f(7, 6))
+            };
+
+            List<PolygonPair> sources;
+            List<Polygon2f> faces = PolygonOverlay2.Overlay(A, B, out sources);
+
+            Assert.AreEqual(4, faces.Count);
+
+            for (int i = 0; i < sources.Count; i++)
+            {
+                if (sources[i].A == 0 && sources[i].B == -1)
+                {
+                    Assert.AreEqual(1, faces[i].HoleCount);
+                    Assert.AreEqual(30 - 4, sources[i].Area, 1e-4);
+                }
+                else if (sources[i].B == 0)
+                {
+                    Assert.AreEqual(-1, sources[i].A);
+                    Assert.AreEqual(1, sources[i].Area, 1e-4);
+                }
+                else if (sources[i].A == 0)
+                {
+                    Assert.AreEqual(1, sources[i].B);
+                    Assert.AreEqual(6, sources[i].Area, 1e-4);
+                }
+                else
+                {
+                    Assert.AreEqual(1, sources[i].B);
+                    Assert.AreEqual(6, sources[i].Area, 1e-4);
+                }
+            }
+        }
+
+    }
+}
@@ -4,6 +4,7 @@ using Microsoft.VisualStudio.TestTools.UnitTesting;
 
 using Common.Core.LinearAlgebra;
 using CGAL.Polygons;
+using CGAL.Polygons.Descriptors;
 
 namespace CGAL.Polygons.Test
 {
@@ -43,5 +44,136 @@ namespace CGAL.Polygons.Test
             }
 
         }
+
+        [TestMethod]
+        public void BatchPartition()
+        {
+            List<Polygon2f> polygons = new List<Polygon2f>();
+            polygons.Add(CreatePolygon2.FromBox(new Vector2f(0), new Vector2f(1)));
+
+            Vector2f[] points = new Vector2f[]
+            {
+                new Vector2f(0, 0),
+                new Vector2f(2, 0),
+                new Vector2f(2, 2),
+                new Vector2f(1, 1),
+                new Vector2f(0, 2)
+            };
+
+            polygons.Add(new Polygon2f(points));
+            polygons.Add(CreatePolygon2.FromCircle(new Vector2f(5), 1, 16));
+
+            foreach (PARTITION_METHOD method in Enum.GetValues(typeof(PARTITION_METHOD)))
+            {
+                List<List<Polygon2f>> partitions = PolygonPartition2.BatchPartition(polygons, method);
+
+                Assert.AreEqual(polygons.Count, partitions.Count);
+                Assert.AreEqual(1, partitions[0].Count);
+                Assert.AreEqual(1, partitions[2].Count);
+
+                if (method != PARTITION_METHOD.YMONOTONE && method != PARTITION_METHOD.TRIANGULATION)
+                    Assert.AreEqual(2, partitions[1].Count);
+
+                for (int i = 0; i < partitions.Count; i++)
+                {
+                    float area = 0;
+                    foreach (Polygon2f poly in partitions[i])
+                    {
+                        Assert.IsTrue(poly.IsSimple);
+                        Assert.IsTrue(poly.IsCCW);
+
+                        if (method != PARTITION_METHOD.YMONOTONE)
+                            Assert.IsTrue(poly.IsConvex);
+
+                        area += poly.Area;
+                    }
+
+                    Assert.AreEqual(polygons[i].Area, area, 1e-4f);
+                }
+            }
+        }
+
+        [TestMethod]
+        public void AutoPartition()
+        {
+            //Comb with 8 teeth. Every notch between teeth has two reflex vertices.
+            List<Vector2f> points = new List<Vector2f>();
+            points.Add(new Vector2f(0, 0));
+            points.Add(new Vector2f(16, 0));
+
+            for (int i = 8; i > 0; i--)
+            {
+                points.Add(new Vector2f(i * 2, 2));
+                points.Add(new Vector2f(i * 2 - 1, 2));
+
+                if (i > 1)
+                {
+                    points.Add(new Vector2f(i * 2 - 1, 1));
+                    points.Add(new Vector2f(i * 2 - 2, 1));
+                }
+            }
+
+            Polygon2f polygon = new Polygon2f(points);
+            PartitionReport report;
+
+            List<Polygon2f> partition = PolygonPartition2.Partition(polygon, PARTITION_METHOD.AUTO, out report);
+
+            Assert.AreEqual(PARTITION_METHOD.OPTIMAL, report.Method);
+            Assert.AreEqual(partition.Count, report.Parts);
+            Assert.IsTrue(report.Parts >= report.LowerBound);
+
+            PolygonPartition2.SetAutoPartition(0, PARTITION_METHOD.APPROX);
+            partition = PolygonPartition2.Partition(polygon, PARTITION_METHOD.AUTO, out report);
+
+            Assert.AreEqual(PARTITION_METHOD.APPROX, report.Method);
+            Assert.AreEqual(partition.Count, report.Parts);
+
+            foreach (Polygon2f poly in partition)
+                Assert.IsTrue(poly.IsConvex);
+
+            Polygon2f box = CreatePolygon2.FromBox(new Vector2f(0), new Vector2f(1));
+            partition = PolygonPartition2.Partition(box, PARTITION_METHOD.AUTO, out report);
+
+            Assert.AreEqual(PARTITION_METHOD.OPTIMAL, report.Method);
+            Assert.AreEqual(1, report.Parts);
+
+            PolygonPartition2.SetAutoPartition(-1);
+        }
+
+        [TestMethod]
+        public void TriangulationPartition()
+        {
+            Polygon2f polygon = CreatePolygon2.FromBox(new Vector2f(-2), new Vector2f(2));
+            Polygon2f hole = CreatePolygon2.FromBox(new Vector2f(-1), new Vector2f(1));
+            hole.MakeCW();
+            polygon.AddHole(hole);
+
+            PartitionReport report;
+            List<Polygon2f> partition = PolygonPartition2.Partition(polygon, PARTITION_METHOD.TRIANGULATION, out report);
+
+            Assert.AreEqual(PARTITION_METHOD.TRIANGULATION, report.Method);
+            Assert.AreEqual(partition.Count, report.Parts);
+            Assert.IsTrue(partition.Count >= 4);
+
+            float area = 0;
+            foreach (Polygon2f poly in partition)
+            {
+                Assert.IsTrue(poly.IsSimple);
+                Assert.IsTrue(poly.IsConvex);
+                Assert.IsTrue(poly.IsCCW);
+                area += poly.Area;
+            }
+
+            Assert.AreEqual(12.0f, area, 1e-4f);
+
+            List<Polygon2f> polygons = new List<Polygon2f>();
+            polygons.Add(polygon);
+            polygons.Add(CreatePolygon2.FromCircle(new Vector2f(10), 1, 16));
+
+            List<List<Polygon2f>> partitions = PolygonPartition2.BatchPartition(polygons, PARTITION_METHOD.TRIANGULATION);
+
+            Assert.AreEqual(partition.Count, partitions[0].Count);
+            Assert.AreEqual(1, partitions[1].Count);
+        }
     }
 }
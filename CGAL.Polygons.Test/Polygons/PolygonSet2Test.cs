@@ -0,0 +1,59 @@
+﻿using System;
+using System.Collections.Generic;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+
+using Common.Core.LinearAlgebra;
+using CGAL.Polygons;
+
+namespace CGAL.Polygons.Test
+{
+    [TestClass]
+    public class PolygonSet2Test
+    {
+        [TestMethod]
+        public void JoinAndDifference()
+        {
+            PolygonSet2.Release();
+
+            Polygon2f A = CreatePolygon2.FromBox(new Vector2f(-1), new Vector2f(1));
+            Polygon2f B = CreatePolygon2.FromBox(new Vector2f(0), new Vector2f(2));
+            Polygon2f C = CreatePolygon2.FromBox(new Vector2f(10), new Vector2f(11));
+            Polygon2f D = CreatePolygon2.FromBox(new Vector2f(-0.5f), new Vector2f(0.5f));
+
+            PolygonSet2.Join(A);
+            PolygonSet2.Join(B);
+            PolygonSet2.Join(C);
+
+            var polygons = PolygonSet2.GetPolygons();
+            Assert.AreEqual(2, polygons.Count);
+
+            List<int> removed = new List<int>();
+            Dictionary<int, Polygon2f> added = new Dictionary<int, Polygon2f>();
+            PolygonSet2.GetChanges(removed, added);
+
+            Assert.AreEqual(0, removed.Count);
+            Assert.AreEqual(2, added.Count);
+
+            removed.Clear();
+            added.Clear();
+
+            PolygonSet2.Difference(D);
+            PolygonSet2.GetChanges(removed, added);
+
+            //Only the component touched by D is rebuilt.
+            Assert.AreEqual(1, removed.Count);
+            Assert.AreEqual(1, added.Count);
+
+            foreach (var polygon in added.Values)
+            {
+                Assert.AreEqual(1, polygon.HoleCount);
+                Assert.AreEqual(6, polygon.Area);
+            }
+
+            PolygonSet2.Intersect(C);
+            Assert.AreEqual(1, PolygonSet2.Count);
+
+            PolygonSet2.Release();
+        }
+    }
+}
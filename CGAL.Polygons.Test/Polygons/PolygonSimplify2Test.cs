@@ -1,4 +1,5 @@
 ﻿using System;
+using System.Collections.Generic;
 using Microsoft.VisualStudio.TestTools.UnitTesting;
 
 using Common.Core.LinearAlgebra;
@@ -39,5 +40,169 @@ namespace CGAL.Polygons.Test
             Assert.AreEqual(ORIENTATION.COUNTERCLOCKWISE, simpified.Orientation);
             Assert.AreEqual(7, simpified.Positions.Length);
         }
+
+        [TestMethod]
+        public void SimplifyProgressive()
+        {
+            Vector2f[] points = new Vector2f[]
+            {
+                new Vector2f(391, 374),
+                new Vector2f(240, 431),
+                new Vector2f(252, 340),
+                new Vector2f(374, 320),
+                new Vector2f(289, 214),
+                new Vector2f(134, 390),
+                new Vector2f(68, 186),
+                new Vector2f(154, 259),
+                new Vector2f(161, 107),
+                new Vector2f(435, 108),
+                new Vector2f(208, 148),
+                new Vector2f(295, 160),
+                new Vector2f(421, 212),
+                new Vector2f(441, 303)
+            };
+
+            Polygon2f polygon = new Polygon2f(points);
+
+            ProgressivePolygon2f progressive = PolygonSimplify2.SimplifyProgressive(polygon);
+
+            Assert.IsTrue(progressive.MinCount >= 3);
+            Assert.AreEqual(points.Length - progressive.MinCount, progressive.RemovalOrder.Length);
+
+            Polygon2f level = progressive.GetLevel(0.5f);
+            Polygon2f simplified = PolygonSimplify2.Simplify(polygon, 0.5f);
+
+            CollectionAssert.AreEquivalent(simplified.Positions, level.Positions);
+
+            Assert.AreEqual(points.Length, progressive.GetLevel(1.0f).Positions.Length);
+            Assert.AreEqual(points.Length, progressive.GetLevelAtCost(-1.0f).Positions.Length);
+            Assert.AreEqual(progressive.MinCount, progressive.GetLevelAtCost(float.MaxValue).Positions.Length);
+
+            int previous = points.Length;
+            foreach (Polygon2f lod in progressive.GetLevels(new float[] { 1.0f, 0.8f, 0.6f, 0.4f, 0.2f }))
+            {
+                Assert.IsTrue(lod.IsSimple);
+                Assert.IsTrue(lod.Positions.Length <= previous);
+                previous = lod.Positions.Length;
+            }
+
+            //Levels can be taken in any order.
+            CollectionAssert.AreEqual(points, progressive.GetLevel(1.0f).Positions);
+
+            //Thresholds just above each cost, clear of float rounding.
+            foreach (float cost in progressive.RemovalCosts)
+            {
+                Polygon2f atCost = progressive.GetLevelAtCost(cost * 1.01f);
+                Assert.AreEqual(PolygonSimplify2.SimplifyToCost(polygon, cost * 1.01f).Positions.Length, atCost.Positions.Length);
+            }
+        }
+
+        [TestMethod]
+        public void SimplifyBatch()
+        {
+            //Two parcels sharing a jagged boundary along x = 1.
+            List<Vector2f> shared = new List<Vector2f>();
+            for (int i = 1; i < 20; i++)
+                shared.Add(new Vector2f(1 + ((i % 2 == 0) ? 0.01f : -0.01f) * (i % 3), i * 0.05f));
+
+            List<Vector2f> left = new List<Vector2f>();
+            left.Add(new Vector2f(0, 0));
+            left.Add(new Vector2f(1, 0));
+            left.AddRange(shared);
+            left.Add(new Vector2f(1, 1));
+            left.Add(new Vector2f(0, 1));
+
+            List<Vector2f> right = new List<Vector2f>();
+            right.Add(new Vector2f(1, 0));
+            right.Add(new Vector2f(2, 0));
+            right.Add(new Vector2f(2, 1));
+            right.Add(new Vector2f(1, 1));
+            for (int i = shared.Count - 1; i >= 0; i--)
+                right.Add(shared[i]);
+
+            List<Polygon2f> polygons = new List<Polygon2f>();
+            polygons.Add(new Polygon2f(left));
+            polygons.Add(new Polygon2f(right));
+            polygons.Add(CreatePolygon2.FromCircle(new Vector2f(10), 1, 32));
+
+            List<Polygon2f> simplified = PolygonSimplify2.SimplifyBatch(polygons, 0.5f);
+
+            Assert.AreEqual(3, simplified.Count);
+            Assert.IsTrue(simplified[2].Positions.Length < 32);
+
+            List<Vector2f> leftShared = new List<Vector2f>();
+            foreach (Vector2f p in simplified[0].Positions)
+                if (p.x > 0.5f && p.y > 0 && p.y < 1) leftShared.Add(p);
+
+            List<Vector2f> rightShared = new List<Vector2f>();
+            foreach (Vector2f p in simplified[1].Positions)
+                if (p.x < 1.5f && p.y > 0 && p.y < 1) rightShared.Add(p);
+
+            CollectionAssert.AreEquivalent(leftShared, rightShared);
+
+            foreach (Polygon2f polygon in simplified)
+                Assert.IsTrue(polygon.IsSimple);
+        }
+
+        [TestMethod]
+        public void SimplifyStream()
+        {
+            int count = 10000;
+            Vector2f[] polyline = new Vector2f[count];
+            for (int i = 0; i < count; i++)
+                polyline[i] = new Vector2f(i * 0.01f, (float)Math.Sin(i * 0.01f));
+
+            HashSet<Vector2f> input = new HashSet<Vector2f>(polyline);
+            List<Vector2f> output = new List<Vector2f>();
+
+            PolygonSimplify2.BeginStream(0.25f, 256);
+
+            for (int i = 0; i < count; i += 100)
+            {
+                Vector2f[] chunk = new Vector2f[100];
+                Array.Copy(polyline, i, chunk, 0, 100);
+                PolygonSimplify2.PushStream(chunk, output);
+            }
+
+            PolygonSimplify2.EndStream(output);
+
+            Assert.IsTrue(output.Count > 2);
+            Assert.IsTrue(output.Count < count / 2);
+            Assert.AreEqual(polyline[0], output[0]);
+            Assert.AreEqual(polyline[count - 1], output[output.Count - 1]);
+
+            for (int i = 0; i < output.Count; i++)
+            {
+                Assert.IsTrue(input.Contains(output[i]));
+                if (i > 0) Assert.IsTrue(output[i].x > output[i - 1].x);
+            }
+        }
+
+        [TestMethod]
+        public void SimplifyThresholds()
+        {
+            Polygon2f polygon = CreatePolygon2.FromCircle(new Vector2f(0), 10, 64);
+
+            Polygon2f byCount = PolygonSimplify2.SimplifyToCount(polygon, 16);
+            Assert.AreEqual(16, byCount.VerticesCount);
+
+            Polygon2f byCost = PolygonSimplify2.SimplifyToCost(polygon, 1000.0f);
+            Assert.IsTrue(byCost.VerticesCount < 64);
+
+            float[] counts = new float[] { 48, 32, 16, 8 };
+            List<Polygon2f> many = PolygonSimplify2.SimplifyMany(polygon, counts, SIMPLIFY_STOP.COUNT);
+
+            Assert.AreEqual(counts.Length, many.Count);
+            for (int i = 0; i < counts.Length; i++)
+                Assert.AreEqual((int)counts[i], many[i].VerticesCount);
+
+            CollectionAssert.AreEquivalent(byCount.Positions, many[2].Positions);
+
+            float[] costs = new float[] { 0.0f, 1000.0f };
+            List<Polygon2f> byCosts = PolygonSimplify2.SimplifyMany(polygon, costs, SIMPLIFY_STOP.COST);
+
+            Assert.AreEqual(64, byCosts[0].VerticesCount);
+            Assert.AreEqual(byCost.VerticesCount, byCosts[1].VerticesCount);
+        }
     }
 }
@@ -1,4 +1,5 @@
 ﻿using System;
+using System.Collections.Generic;
 using Microsoft.VisualStudio.TestTools.UnitTesting;
 
 using Common.Core.LinearAlgebra;
@@ -24,5 +25,107 @@ namespace CGAL.Polygons.Test
             Assert.AreEqual(8, mesh.Edges.Count);
             Assert.AreEqual(0, mesh.Faces.Count);
         }
+
+        [TestMethod]
+        public void CreateOffsets()
+        {
+            Polygon2f polygon = CreatePolygon2.FromBox(new Vector2f(-1), new Vector2f(1));
+
+            float[] offsets = new float[] { 0.25f, 0.5f, 1.5f };
+            var interior = PolygonSkeleton2.CreateOffsets(polygon, offsets);
+
+            Assert.AreEqual(3, interior.Length);
+            Assert.AreEqual(1, interior[0].Count);
+            Assert.AreEqual(1, interior[1].Count);
+            Assert.AreEqual(0, interior[2].Count);
+
+            Assert.AreEqual(2.25f, interior[0][0].Area, 1e-4f);
+            Assert.AreEqual(1.0f, interior[1][0].Area, 1e-4f);
+
+            var exterior = PolygonSkeleton2.CreateOffsets(polygon, new float[] { 0.5f }, true);
+
+            Assert.AreEqual(1, exterior[0].Count);
+            Assert.IsTrue(exterior[0][0].IsCCW);
+            Assert.AreEqual(9.0f, exterior[0][0].Area, 1e-4f);
+        }
+
+        [TestMethod]
+        public void ExportInteriorSkeleton()
+        {
+            Polygon2f polygon = CreatePolygon2.FromBox(new Vector2f(-1), new Vector2f(1));
+
+            Skeleton2f skeleton = PolygonSkeleton2.CreateInteriorSkeleton(polygon);
+
+            Assert.AreEqual(5, skeleton.Points.Length);
+            Assert.AreEqual(4, skeleton.Edges.Length);
+            Assert.AreEqual(8, skeleton.Connections.Length);
+
+            int contour = 0;
+            for (int i = 0; i < skeleton.Points.Length; i++)
+            {
+                if (skeleton.IsContour[i])
+                {
+                    contour++;
+                    Assert.AreEqual(0.0f, skeleton.Times[i]);
+                }
+                else
+                    Assert.AreEqual(1.0f, skeleton.Times[i], 1e-6f);
+            }
+
+            Assert.AreEqual(4, contour);
+        }
+
+        [TestMethod]
+        public void BatchOffsets()
+        {
+            Polygon2f frame = CreatePolygon2.FromBox(new Vector2f(-2), new Vector2f(2));
+            Polygon2f hole = CreatePolygon2.FromBox(new Vector2f(-1), new Vector2f(1));
+            hole.MakeCW();
+            frame.AddHole(hole);
+            frame.CalculatePolygon();
+
+            List<Polygon2f> polygons = new List<Polygon2f>();
+            polygons.Add(frame);
+            polygons.Add(CreatePolygon2.FromBox(new Vector2f(10), new Vector2f(12)));
+
+            var exterior = PolygonSkeleton2.CreateOffsets(polygons, new float[] { 0.5f }, true);
+
+            Assert.AreEqual(2, exterior.Length);
+            Assert.AreEqual(1, exterior[0][0].Count);
+            Assert.AreEqual(1, exterior[0][0][0].HoleCount);
+            Assert.AreEqual(24.0f, exterior[0][0][0].Area, 1e-3f);
+            Assert.AreEqual(1, exterior[1][0].Count);
+
+            var skeletons = PolygonSkeleton2.CreateSkeletons(polygons);
+
+            Assert.AreEqual(2, skeletons.Length);
+            Assert.AreEqual(5, skeletons[1].Points.Length);
+            Assert.AreEqual(4, skeletons[1].Edges.Length);
+        }
+
+        [TestMethod]
+        public void CreateApproximateMedialAxis()
+        {
+            Polygon2f polygon = CreatePolygon2.FromBox(new Vector2f(-4, -1), new Vector2f(4, 1));
+
+            Skeleton2f axis = PolygonSkeleton2.CreateApproximateMedialAxis(polygon, 0.05f);
+
+            Assert.IsTrue(axis.Points.Length > 0);
+            Assert.AreEqual(axis.Edges.Length * 2, axis.Connections.Length);
+
+            bool centre = false;
+            for (int i = 0; i < axis.Points.Length; i++)
+            {
+                Vector2f p = axis.Points[i];
+
+                Assert.IsTrue(Math.Abs(p.x) < 4 && Math.Abs(p.y) < 1);
+                Assert.IsFalse(axis.IsContour[i]);
+                Assert.IsTrue(axis.Times[i] <= 1.01f);
+
+                if (Math.Abs(p.x) < 2 && Math.Abs(p.y) < 0.01f) centre = true;
+            }
+
+            Assert.IsTrue(centre);
+        }
     }
 }
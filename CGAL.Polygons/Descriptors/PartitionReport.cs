@@ -0,0 +1,18 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+
+namespace CGAL.Polygons.Descriptors
+{
+    [StructLayout(LayoutKind.Sequential)]
+    public struct PartitionReport
+    {
+        public PARTITION_METHOD Method;
+        public int Parts, LowerBound;
+
+        public override string ToString()
+        {
+            return string.Format("[PartitionReport: method={0}, parts={1}, lowerBound={2}]", Method, Parts, LowerBound);
+        }
+    }
+}
\ No newline at end of file
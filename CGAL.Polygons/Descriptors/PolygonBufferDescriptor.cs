@@ -0,0 +1,17 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+
+namespace CGAL.Polygons.Descriptors
+{
+    [StructLayout(LayoutKind.Sequential)]
+    public struct PolygonBufferDescriptor
+    {
+        public int Polygons, Rings, Points;
+
+        public override string ToString()
+        {
+            return string.Format("[PolygonBufferDescriptor: polygons={0}, rings={1}, points={2}]", Polygons, Rings, Points);
+        }
+    }
+}
@@ -0,0 +1,18 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+
+namespace CGAL.Polygons.Descriptors
+{
+    [StructLayout(LayoutKind.Sequential)]
+    public struct PolygonPair
+    {
+        public int A, B;
+        public double Area;
+
+        public override string ToString()
+        {
+            return string.Format("[PolygonPair: a={0}, b={1}, area={2}]", A, B, Area);
+        }
+    }
+}
@@ -0,0 +1,31 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+
+using Common.Core.LinearAlgebra;
+
+namespace CGAL.Polygons.Descriptors
+{
+    [StructLayout(LayoutKind.Sequential)]
+    public struct PolygonProperties
+    {
+        public double Area, Perimeter;
+        public double CentroidX, CentroidY;
+        public float XMin, YMin, XMax, YMax;
+        public int Simple, Convex;
+        public ORIENTATION Orientation;
+
+        public bool SimpleChecked { get { return Simple != -1; } }
+
+        public bool IsSimple { get { return Simple == 1; } }
+
+        public bool IsConvex { get { return Convex == 1; } }
+
+        public Vector2f Centroid { get { return new Vector2f((float)CentroidX, (float)CentroidY); } }
+
+        public override string ToString()
+        {
+            return string.Format("[PolygonProperties: area={0}, perimeter={1}, simple={2}, convex={3}, orientation={4}]", Area, Perimeter, Simple, Convex, Orientation);
+        }
+    }
+}
\ No newline at end of file
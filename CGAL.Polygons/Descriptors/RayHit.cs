@@ -0,0 +1,23 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+
+namespace CGAL.Polygons.Descriptors
+{
+    [StructLayout(LayoutKind.Sequential)]
+    public struct RayHit
+    {
+        public float Distance;
+        public int Polygon, Edge;
+
+        public bool Hit
+        {
+            get { return Polygon != -1; }
+        }
+
+        public override string ToString()
+        {
+            return string.Format("[RayHit: distance={0}, polygon={1}, edge={2}]", Distance, Polygon, Edge);
+        }
+    }
+}
\ No newline at end of file
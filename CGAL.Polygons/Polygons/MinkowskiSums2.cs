@@ -3,9 +3,13 @@ using System.Collections.Generic;
 using System.Runtime.InteropServices;
 
 using Common.Core.LinearAlgebra;
+using CGAL.Polygons.Descriptors;
 
 namespace CGAL.Polygons
 {
+
+    public enum MINKOWSKI_STRATEGY { AUTO, CONVEX, REDUCED_CONVOLUTION, SSAB, TRIANGULATION, OPTIMAL };
+
     public static class MinkowskiSums2
     {
 
@@ -13,6 +17,15 @@ namespace CGAL.Polygons
         private const int ERROR = 1;
 
         public static Polygon2f ComputeSum(Polygon2f A, Polygon2f B)
+        {
+            MINKOWSKI_STRATEGY used;
+            return ComputeSum(A, B, MINKOWSKI_STRATEGY.AUTO, out used);
+        }
+
+        //Convex operands are merged in linear time. Auto picks the strategy
+        //from the operand sizes and reflex vertex counts. Convex falls back
+        //to auto if either operand is not convex.
+        public static Polygon2f ComputeSum(Polygon2f A, Polygon2f B, MINKOWSKI_STRATEGY strategy, out MINKOWSKI_STRATEGY used)
         {
             if (!A.IsSimple || !B.IsSimple)
                 throw new ArgumentException("Polygon must be simple.");
@@ -25,8 +38,13 @@ namespace CGAL.Polygons
 
             LoadPoints(A, B);
 
-            if (CGAL_ComputeSum() != SUCCESS)
+            if (CGAL_ComputeSumWith((int)strategy) != SUCCESS)
+            {
+                CGAL_Clear();
                 throw new Exception("Error computing sum.");
+            }
+
+            used = (MINKOWSKI_STRATEGY)CGAL_GetStrategy();
 
             Polygon2f sum = CreatePolygon();
 
@@ -41,6 +59,118 @@ namespace CGAL.Polygons
             CGAL_B_LoadPoints(B.Positions, B.Positions.Length);
         }
 
+        //Sums B against every obstacle. B is decomposed once for the convex
+        //obstacles of the batch and the obstacles may have holes. Reflect B through the origin to get
+        //the configuration space obstacles of a robot with footprint B.
+        public static List<Polygon2f>[] ComputeSums(IList<Polygon2f> obstacles, Polygon2f B, bool reflectB = false)
+        {
+            int[] polygonOffsets = new int[obstacles.Count + 1];
+            List<Polygon2f> all = BatchSum(obstacles, B, reflectB, false, polygonOffsets);
+
+            return Split(all, polygonOffsets);
+        }
+
+        //As ComputeSums but unions the sums in the same call. The free space
+        //is the complement of the returned polygons.
+        public static List<Polygon2f> ComputeSumsUnion(IList<Polygon2f> obstacles, Polygon2f B, bool reflectB = false)
+        {
+            return BatchSum(obstacles, B, reflectB, true, null);
+        }
+
+        //Grows the polygon by the radius, or shrinks it if negative, without a
+        //disk shaped sum. Arcs are output as chords within the tolerance.
+        public static List<Polygon2f> Offset(Polygon2f polygon, float radius, float tolerance)
+        {
+            return Offset(new List<Polygon2f>() { polygon }, radius, tolerance)[0];
+        }
+
+        public static List<Polygon2f>[] Offset(IList<Polygon2f> polygons, float radius, float tolerance)
+        {
+            if (tolerance <= 0)
+                throw new ArgumentException("Tolerance must be positive.");
+
+            CheckPolygons(polygons);
+
+            PolygonBuffer2f input = new PolygonBuffer2f(polygons);
+
+            PolygonBufferDescriptor descriptor;
+            if (CGAL_Offset(input.Points, input.RingSizes, input.PolygonRings, input.PolygonCount, radius, tolerance, out descriptor) != SUCCESS)
+            {
+                CGAL_Clear();
+                throw new Exception("Error computing offset.");
+            }
+
+            PolygonBuffer2f buffer = new PolygonBuffer2f(descriptor);
+            int[] polygonOffsets = new int[polygons.Count + 1];
+            CGAL_GetOffset(buffer.Points, buffer.RingSizes, buffer.PolygonRings, polygonOffsets);
+
+            CGAL_Clear();
+
+            return Split(buffer.ToPolygons(), polygonOffsets);
+        }
+
+        private static List<Polygon2f>[] Split(List<Polygon2f> all, int[] polygonOffsets)
+        {
+            List<Polygon2f>[] results = new List<Polygon2f>[polygonOffsets.Length - 1];
+            for (int i = 0; i < results.Length; i++)
+            {
+                int count = polygonOffsets[i + 1] - polygonOffsets[i];
+                results[i] = all.GetRange(polygonOffsets[i], count);
+            }
+
+            return results;
+        }
+
+        private static List<Polygon2f> BatchSum(IList<Polygon2f> obstacles, Polygon2f B, bool reflectB, bool unionSums, int[] polygonOffsets)
+        {
+            if (!B.IsSimple)
+                throw new ArgumentException("Polygon must be simple.");
+
+            if (!B.IsCCW)
+                throw new ArgumentException("Polygon must have counter clock wise orientation. Reverse polygon.");
+
+            if (B.HasHoles)
+                throw new NotImplementedException("Polygon B with holes not implemented.");
+
+            CheckPolygons(obstacles);
+
+            PolygonBuffer2f input = new PolygonBuffer2f(obstacles);
+
+            PolygonBufferDescriptor descriptor;
+            if (CGAL_BatchSum(B.Positions, B.Positions.Length, reflectB, input.Points, input.RingSizes, input.PolygonRings, input.PolygonCount, unionSums, out descriptor) != SUCCESS)
+            {
+                CGAL_Clear();
+                throw new Exception("Error computing sums.");
+            }
+
+            PolygonBuffer2f buffer = new PolygonBuffer2f(descriptor);
+            CGAL_GetBatchSum(buffer.Points, buffer.RingSizes, buffer.PolygonRings, polygonOffsets);
+
+            CGAL_Clear();
+
+            return buffer.ToPolygons();
+        }
+
+        private static void CheckPolygons(IList<Polygon2f> polygons)
+        {
+            for (int i = 0; i < polygons.Count; i++)
+            {
+                Polygon2f polygon = polygons[i];
+
+                if (!polygon.IsSimple)
+                    throw new ArgumentException("Polygon must be simple.");
+
+                if (!polygon.IsCCW)
+                    throw new ArgumentException("Polygon must have counter clock wise orientation. Reverse polygon.");
+
+                for (int j = 0; j < polygon.HoleCount; j++)
+                {
+                    if (!polygon.Holes[j].IsCW)
+                        throw new ArgumentException("Hole must have clock wise orientation.");
+                }
+            }
+        }
+
         private static Polygon2f CreatePolygon()
         {
             int numPoints = CGAL_NumPolygonPoints();
@@ -83,6 +213,12 @@ namespace CGAL.Polygons
         [DllImport("CGALWrapper", EntryPoint = "MinkowskiSums2_ComputeSum", CallingConvention = CallingConvention.Cdecl)]
         private static extern int CGAL_ComputeSum();
 
+        [DllImport("CGALWrapper", EntryPoint = "MinkowskiSums2_ComputeSumWith", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_ComputeSumWith(int strategy);
+
+        [DllImport("CGALWrapper", EntryPoint = "MinkowskiSums2_GetStrategy", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_GetStrategy();
+
         [DllImport("CGALWrapper", EntryPoint = "MinkowskiSums2_NumPolygonPoints", CallingConvention = CallingConvention.Cdecl)]
         private static extern int CGAL_NumPolygonPoints();
 
@@ -98,5 +234,17 @@ namespace CGAL.Polygons
         [DllImport("CGALWrapper", EntryPoint = "MinkowskiSums2_GetHolePoint2f", CallingConvention = CallingConvention.Cdecl)]
         private static extern Vector2f CGAL_GetHolePoint2f(int holeIndex, int pointIndex);
 
+        [DllImport("CGALWrapper", EntryPoint = "MinkowskiSums2_BatchSum2f", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_BatchSum(Vector2f[] inB, int bSize, bool reflectB, Vector2f[] inPoints, int[] inRingSizes, int[] inPolygonRings, int numPolygons, bool unionSums, out PolygonBufferDescriptor descriptor);
+
+        [DllImport("CGALWrapper", EntryPoint = "MinkowskiSums2_GetBatchSum2f", CallingConvention = CallingConvention.Cdecl)]
+        private static extern void CGAL_GetBatchSum([Out] Vector2f[] outPoints, [Out] int[] outRingSizes, [Out] int[] outPolygonRings, [Out] int[] outPolygonOffsets);
+
+        [DllImport("CGALWrapper", EntryPoint = "MinkowskiSums2_Offset2f", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_Offset(Vector2f[] inPoints, int[] inRingSizes, int[] inPolygonRings, int numPolygons, double radius, double tolerance, out PolygonBufferDescriptor descriptor);
+
+        [DllImport("CGALWrapper", EntryPoint = "MinkowskiSums2_GetOffset2f", CallingConvention = CallingConvention.Cdecl)]
+        private static extern void CGAL_GetOffset([Out] Vector2f[] outPoints, [Out] int[] outRingSizes, [Out] int[] outPolygonRings, [Out] int[] outPolygonOffsets);
+
     }
 }
@@ -4,6 +4,7 @@ using System.Runtime.InteropServices;
 
 using Common.Core.LinearAlgebra;
 using CGAL.Meshes.IndexBased;
+using CGAL.Polygons.Descriptors;
 
 namespace CGAL.Polygons
 {
@@ -158,6 +159,72 @@ namespace CGAL.Polygons
                 Holes[i].MakeCCW();
         }
 
+        //Properties of many polygons in one call. Area, centroid and perimeter
+        //include the holes. Simplicity is only checked if asked for.
+        public static PolygonProperties[] BatchProperties(IList<Polygon2f> polygons, bool checkSimple = false)
+        {
+            return BatchProperties(new PolygonBuffer2f(polygons), checkSimple);
+        }
+
+        public static PolygonProperties[] BatchProperties(PolygonBuffer2f buffer, bool checkSimple = false)
+        {
+            PolygonProperties[] properties = new PolygonProperties[buffer.PolygonCount];
+
+            if (CGAL_BatchProperties(buffer.Points, buffer.RingSizes, buffer.PolygonRings, buffer.PolygonCount, checkSimple, properties) != SUCCESS)
+                throw new Exception("Error evaluating polygon properties.");
+
+            return properties;
+        }
+
+        //Sorts unordered rings into polygons with holes by nesting depth. Rings
+        //at even depth become outer boundaries and rings at odd depth holes of
+        //the ring containing them. Rings must be simple and not cross.
+        public static List<Polygon2f> FromRings(IList<Polygon2f> rings)
+        {
+            int[] depths, parents;
+            return FromRings(rings, out depths, out parents);
+        }
+
+        public static List<Polygon2f> FromRings(IList<Polygon2f> rings, out int[] depths, out int[] parents)
+        {
+            int numPoints = 0;
+            for (int i = 0; i < rings.Count; i++)
+            {
+                if (rings[i].HasHoles)
+                    throw new ArgumentException("Ring can not have holes.");
+
+                numPoints += rings[i].Positions.Length;
+            }
+
+            Vector2f[] points = new Vector2f[numPoints];
+            int[] ringSizes = new int[rings.Count];
+
+            int point = 0;
+            for (int i = 0; i < rings.Count; i++)
+            {
+                Vector2f[] positions = rings[i].Positions;
+                Array.Copy(positions, 0, points, point, positions.Length);
+                ringSizes[i] = positions.Length;
+                point += positions.Length;
+            }
+
+            PolygonBufferDescriptor descriptor;
+            if (CGAL_BuildHierarchy(points, ringSizes, rings.Count, out descriptor) != SUCCESS)
+            {
+                CGAL_Release();
+                throw new Exception("Error building ring hierarchy.");
+            }
+
+            PolygonBuffer2f buffer = new PolygonBuffer2f(descriptor);
+            depths = new int[rings.Count];
+            parents = new int[rings.Count];
+            CGAL_GetHierarchy(buffer.Points, buffer.RingSizes, buffer.PolygonRings, depths, parents);
+
+            CGAL_Release();
+
+            return buffer.ToPolygons();
+        }
+
         [DllImport("CGALWrapper", EntryPoint = "Polygon2_LoadPoints2f", CallingConvention = CallingConvention.Cdecl)]
         private static extern void CGAL_LoadPoints(Vector2f[] inPoints, int inSize);
 
@@ -176,5 +243,14 @@ namespace CGAL.Polygons
         [DllImport("CGALWrapper", EntryPoint = "Polygon2_SignedArea", CallingConvention = CallingConvention.Cdecl)]
         private static extern float CGAL_SignedArea();
 
+        [DllImport("CGALWrapper", EntryPoint = "Polygon2_BatchProperties2f", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_BatchProperties(Vector2f[] inPoints, int[] inRingSizes, int[] inPolygonRings, int numPolygons, bool checkSimple, [Out] PolygonProperties[] outProperties);
+
+        [DllImport("CGALWrapper", EntryPoint = "Polygon2_BuildHierarchy2f", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_BuildHierarchy(Vector2f[] inPoints, int[] inRingSizes, int numRings, out PolygonBufferDescriptor descriptor);
+
+        [DllImport("CGALWrapper", EntryPoint = "Polygon2_GetHierarchy2f", CallingConvention = CallingConvention.Cdecl)]
+        private static extern void CGAL_GetHierarchy([Out] Vector2f[] outPoints, [Out] int[] outRingSizes, [Out] int[] outPolygonRings, [Out] int[] outDepths, [Out] int[] outParents);
+
     }
 }
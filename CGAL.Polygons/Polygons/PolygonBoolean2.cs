@@ -3,6 +3,7 @@ using System.Collections.Generic;
 using System.Runtime.InteropServices;
 
 using Common.Core.LinearAlgebra;
+using CGAL.Polygons.Descriptors;
 
 namespace CGAL.Polygons
 {
@@ -10,6 +11,9 @@ namespace CGAL.Polygons
     public static class PolygonBoolean2
     {
 
+        private const int SUCCESS = 0;
+        private const int ERROR = 1;
+
         public static bool DoIntersect(Polygon2f A, Polygon2f B)
         {
             if (!A.IsSimple || !B.IsSimple)
@@ -48,6 +52,101 @@ namespace CGAL.Polygons
             return PerformBoolean(A, B, CGAL_SymmetricDifference, out polygons);
         }
 
+        public static List<PolygonPair> BatchDoIntersect(IList<Polygon2f> A, IList<Polygon2f> B, bool computeArea = false)
+        {
+            CheckPolygons(A);
+            CheckPolygons(B);
+
+            PolygonBuffer2f bufferA = new PolygonBuffer2f(A);
+            PolygonBuffer2f bufferB = new PolygonBuffer2f(B);
+
+            CGAL_Batch_A_LoadPolygons(bufferA.Points, bufferA.RingSizes, bufferA.PolygonRings, bufferA.PolygonCount);
+            CGAL_Batch_B_LoadPolygons(bufferB.Points, bufferB.RingSizes, bufferB.PolygonRings, bufferB.PolygonCount);
+
+            int numPairs = CGAL_BatchDoIntersect(computeArea);
+
+            PolygonPair[] pairs = new PolygonPair[numPairs];
+            CGAL_GetBatchPairs(pairs, numPairs);
+
+            CGAL_Clear();
+
+            return new List<PolygonPair>(pairs);
+        }
+
+        //Cuts the polygons into a grid of columns by rows tiles starting at the
+        //origin. Returns the pieces in each tile, indexed row by row.
+        public static List<Polygon2f>[] ClipToGrid(IList<Polygon2f> polygons, Vector2f origin, Vector2f tileSize, int columns, int rows)
+        {
+            List<int>[] sources;
+            return ClipToGrid(polygons, origin, tileSize, columns, rows, out sources);
+        }
+
+        //As above with the index of the input polygon each piece came from.
+        public static List<Polygon2f>[] ClipToGrid(IList<Polygon2f> polygons, Vector2f origin, Vector2f tileSize, int columns, int rows, out List<int>[] sources)
+        {
+            if (tileSize.x <= 0 || tileSize.y <= 0)
+                throw new ArgumentException("Tile size must be positive.");
+
+            if (columns < 1 || rows < 1)
+                throw new ArgumentException("Grid must have at least one tile.");
+
+            CheckPolygons(polygons);
+
+            PolygonBuffer2f input = new PolygonBuffer2f(polygons);
+
+            PolygonBufferDescriptor descriptor;
+            if (CGAL_ClipToGrid(input.Points, input.RingSizes, input.PolygonRings, input.PolygonCount, origin, tileSize.x, tileSize.y, columns, rows, out descriptor) != SUCCESS)
+            {
+                CGAL_Clear();
+                throw new Exception("Error clipping to grid.");
+            }
+
+            int numTiles = columns * rows;
+            PolygonBuffer2f buffer = new PolygonBuffer2f(descriptor);
+            int[] tileOffsets = new int[numTiles + 1];
+            int[] pieceSources = new int[descriptor.Polygons];
+            CGAL_GetGridTiles(buffer.Points, buffer.RingSizes, buffer.PolygonRings, tileOffsets, pieceSources);
+
+            CGAL_Clear();
+
+            List<Polygon2f> all = buffer.ToPolygons();
+
+            List<Polygon2f>[] tiles = new List<Polygon2f>[numTiles];
+            sources = new List<int>[numTiles];
+
+            for (int i = 0; i < numTiles; i++)
+            {
+                int count = tileOffsets[i + 1] - tileOffsets[i];
+                tiles[i] = all.GetRange(tileOffsets[i], count);
+                sources[i] = new List<int>(count);
+
+                for (int j = tileOffsets[i]; j < tileOffsets[i + 1]; j++)
+                    sources[i].Add(pieceSources[j]);
+            }
+
+            return tiles;
+        }
+
+        private static void CheckPolygons(IList<Polygon2f> polygons)
+        {
+            for (int i = 0; i < polygons.Count; i++)
+            {
+                Polygon2f polygon = polygons[i];
+
+                if (!polygon.IsSimple)
+                    throw new ArgumentException("Polygon must be simple.");
+
+                if (!polygon.IsCCW)
+                    throw new ArgumentException("Polygon must have counter clock wise orientation. Reverse polygon.");
+
+                for (int j = 0; j < polygon.HoleCount; j++)
+                {
+                    if (!polygon.Holes[j].IsCW)
+                        throw new ArgumentException("Hole must have clock wise orientation.");
+                }
+            }
+        }
+
         private static bool PerformBoolean(Polygon2f A, Polygon2f B, Func<int> func, out List<Polygon2f> polygons)
         {
             polygons = null;
@@ -184,5 +283,23 @@ namespace CGAL.Polygons
         [DllImport("CGALWrapper", EntryPoint = "Boolean2_GetHolePoint2f", CallingConvention = CallingConvention.Cdecl)]
         private static extern Vector2f CGAL_GetHolePoint2f(int holeIndex, int pointIndex);
 
+        [DllImport("CGALWrapper", EntryPoint = "Boolean2_Batch_A_LoadPolygons2f", CallingConvention = CallingConvention.Cdecl)]
+        private static extern void CGAL_Batch_A_LoadPolygons(Vector2f[] inPoints, int[] inRingSizes, int[] inPolygonRings, int numPolygons);
+
+        [DllImport("CGALWrapper", EntryPoint = "Boolean2_Batch_B_LoadPolygons2f", CallingConvention = CallingConvention.Cdecl)]
+        private static extern void CGAL_Batch_B_LoadPolygons(Vector2f[] inPoints, int[] inRingSizes, int[] inPolygonRings, int numPolygons);
+
+        [DllImport("CGALWrapper", EntryPoint = "Boolean2_BatchDoIntersect", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_BatchDoIntersect(bool computeArea);
+
+        [DllImport("CGALWrapper", EntryPoint = "Boolean2_GetBatchPairs", CallingConvention = CallingConvention.Cdecl)]
+        private static extern void CGAL_GetBatchPairs([Out] PolygonPair[] outPairs, int size);
+
+        [DllImport("CGALWrapper", EntryPoint = "Boolean2_ClipToGrid2f", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_ClipToGrid(Vector2f[] inPoints, int[] inRingSizes, int[] inPolygonRings, int numPolygons, Vector2f origin, float tileWidth, float tileHeight, int columns, int rows, out PolygonBufferDescriptor descriptor);
+
+        [DllImport("CGALWrapper", EntryPoint = "Boolean2_GetGridTiles2f", CallingConvention = CallingConvention.Cdecl)]
+        private static extern void CGAL_GetGridTiles([Out] Vector2f[] outPoints, [Out] int[] outRingSizes, [Out] int[] outPolygonRings, [Out] int[] outTileOffsets, [Out] int[] outSources);
+
     }
 }
@@ -0,0 +1,97 @@
+﻿using System;
+using System.Collections.Generic;
+
+using Common.Core.LinearAlgebra;
+using CGAL.Polygons.Descriptors;
+
+namespace CGAL.Polygons
+{
+    public class PolygonBuffer2f
+    {
+
+        public Vector2f[] Points { get; private set; }
+
+        public int[] RingSizes { get; private set; }
+
+        public int[] PolygonRings { get; private set; }
+
+        public int PolygonCount { get { return PolygonRings.Length; } }
+
+        public PolygonBuffer2f(PolygonBufferDescriptor descriptor)
+        {
+            Points = new Vector2f[descriptor.Points];
+            RingSizes = new int[descriptor.Rings];
+            PolygonRings = new int[descriptor.Polygons];
+        }
+
+        public PolygonBuffer2f(IList<Polygon2f> polygons)
+        {
+            int numRings = 0, numPoints = 0;
+            for (int i = 0; i < polygons.Count; i++)
+            {
+                Polygon2f polygon = polygons[i];
+                numRings += 1 + polygon.HoleCount;
+                numPoints += polygon.Positions.Length;
+
+                for (int j = 0; j < polygon.HoleCount; j++)
+                    numPoints += polygon.Holes[j].Positions.Length;
+            }
+
+            Points = new Vector2f[numPoints];
+            RingSizes = new int[numRings];
+            PolygonRings = new int[polygons.Count];
+
+            int ring = 0, point = 0;
+            for (int i = 0; i < polygons.Count; i++)
+            {
+                Polygon2f polygon = polygons[i];
+                PolygonRings[i] = 1 + polygon.HoleCount;
+
+                AddRing(polygon, ref ring, ref point);
+
+                for (int j = 0; j < polygon.HoleCount; j++)
+                    AddRing(polygon.Holes[j], ref ring, ref point);
+            }
+        }
+
+        public List<Polygon2f> ToPolygons()
+        {
+            List<Polygon2f> polygons = new List<Polygon2f>(PolygonCount);
+
+            int ring = 0, point = 0;
+            for (int i = 0; i < PolygonCount; i++)
+            {
+                Polygon2f polygon = CreateRing(ref ring, ref point);
+
+                for (int j = 1; j < PolygonRings[i]; j++)
+                    polygon.AddHole(CreateRing(ref ring, ref point));
+
+                polygon.CalculatePolygon();
+                polygons.Add(polygon);
+            }
+
+            return polygons;
+        }
+
+        private void AddRing(Polygon2f polygon, ref int ring, ref int point)
+        {
+            int size = polygon.Positions.Length;
+            Array.Copy(polygon.Positions, 0, Points, point, size);
+
+            RingSizes[ring++] = size;
+            point += size;
+        }
+
+        private Polygon2f CreateRing(ref int ring, ref int point)
+        {
+            int size = RingSizes[ring++];
+            Polygon2f polygon = new Polygon2f(size);
+
+            Array.Copy(Points, point, polygon.Positions, 0, size);
+            point += size;
+
+            return polygon;
+        }
+
+    }
+}
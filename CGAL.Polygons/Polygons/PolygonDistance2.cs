@@ -0,0 +1,53 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+
+using Common.Core.LinearAlgebra;
+
+namespace CGAL.Polygons
+{
+    public static class PolygonDistance2
+    {
+
+        private const int SUCCESS = 0;
+        private const int ERROR = 1;
+
+        //Signed distance from the center of each cell to the nearest polygon edge,
+        //negative inside. Cells are stored row by row starting at min.
+        public static float[] SignedDistanceField(IList<Polygon2f> polygons, Vector2f min, float cellSize, int width, int height)
+        {
+            if (width < 1 || height < 1)
+                throw new ArgumentException("Grid must have at least one cell.");
+
+            if (cellSize <= 0)
+                throw new ArgumentException("Cell size must be positive.");
+
+            for (int i = 0; i < polygons.Count; i++)
+            {
+                Polygon2f polygon = polygons[i];
+
+                if (!polygon.IsCCW)
+                    throw new ArgumentException("Polygon must have counter clock wise orientation. Reverse polygon.");
+
+                for (int j = 0; j < polygon.HoleCount; j++)
+                {
+                    if (!polygon.Holes[j].IsCW)
+                        throw new ArgumentException("Hole must have clock wise orientation.");
+                }
+            }
+
+            PolygonBuffer2f buffer = new PolygonBuffer2f(polygons);
+            float[] field = new float[width * height];
+
+            if (CGAL_SignedDistanceField(buffer.Points, buffer.RingSizes, buffer.PolygonRings, buffer.PolygonCount,
+                min.x, min.y, cellSize, width, height, field) != SUCCESS)
+                throw new Exception("Error computing distance field.");
+
+            return field;
+        }
+
+        [DllImport("CGALWrapper", EntryPoint = "Distance2_SignedDistanceField2f", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_SignedDistanceField(Vector2f[] inPoints, int[] inRingSizes, int[] inPolygonRings, int numPolygons,
+            float xmin, float ymin, float cellSize, int width, int height, [Out] float[] outField);
+    }
+}
\ No newline at end of file
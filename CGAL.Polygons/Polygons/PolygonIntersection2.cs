@@ -3,12 +3,16 @@ using System.Collections.Generic;
 using System.Runtime.InteropServices;
 
 using Common.Core.LinearAlgebra;
+using CGAL.Polygons.Descriptors;
 
 namespace CGAL.Polygons
 {
     public static class PolygonIntersection2
     {
 
+        private const int SUCCESS = 0;
+        private const int ERROR = 1;
+
         public static void PushPolygon(Polygon2f polygon)
         {
             CGAL_PushPolygon(polygon.Positions, polygon.Positions.Length);
@@ -34,11 +38,62 @@ namespace CGAL.Polygons
             CGAL_PopAll();
         }
 
+        public static void SetEdgeGridThreshold(int numEdges)
+        {
+            CGAL_SetEdgeGridThreshold(numEdges);
+        }
+
         public static bool ContainsPoint(Vector2f point)
         {
             return CGAL_ContainsPoint(point);
         }
 
+        public static int[] FindContainingPolygons(Vector2f[] points)
+        {
+            int[] indices = new int[points.Length];
+
+            if (CGAL_BatchContainsPoints(points, points.Length, indices) != SUCCESS)
+                throw new Exception("Error finding containing polygons.");
+
+            return indices;
+        }
+
+        public static byte[] ContainsPointsMask(Vector2f[] points)
+        {
+            byte[] mask = new byte[(points.Length + 7) / 8];
+
+            if (CGAL_BatchContainsPointsMask(points, points.Length, mask) != SUCCESS)
+                throw new Exception("Error finding containing polygons.");
+
+            return mask;
+        }
+
+        public static RayHit[] Raycast(Vector2f[] origins, Vector2f[] directions, float maxDistance)
+        {
+            if (origins.Length != directions.Length)
+                throw new ArgumentException("Origins and directions must be the same length.");
+
+            RayHit[] hits = new RayHit[origins.Length];
+
+            if (CGAL_BatchRaycast(origins, directions, origins.Length, maxDistance, hits) != SUCCESS)
+                throw new Exception("Error casting rays.");
+
+            return hits;
+        }
+
+        public static RayHit[] SegmentHits(Vector2f[] starts, Vector2f[] ends)
+        {
+            if (starts.Length != ends.Length)
+                throw new ArgumentException("Starts and ends must be the same length.");
+
+            RayHit[] hits = new RayHit[starts.Length];
+
+            if (CGAL_BatchSegmentHits(starts, ends, starts.Length, hits) != SUCCESS)
+                throw new Exception("Error testing segments.");
+
+            return hits;
+        }
+
         [DllImport("CGALWrapper", EntryPoint = "Intersection2_PushPolygon2f", CallingConvention = CallingConvention.Cdecl)]
         private static extern void CGAL_PushPolygon(Vector2f[] inPoints, int inSize);
 
@@ -51,7 +106,22 @@ namespace CGAL.Polygons
         [DllImport("CGALWrapper", EntryPoint = "Intersection2_PopAll", CallingConvention = CallingConvention.Cdecl)]
         private static extern void CGAL_PopAll();
 
+        [DllImport("CGALWrapper", EntryPoint = "Intersection2_SetEdgeGridThreshold", CallingConvention = CallingConvention.Cdecl)]
+        private static extern void CGAL_SetEdgeGridThreshold(int numEdges);
+
         [DllImport("CGALWrapper", EntryPoint = "Intersection2_ContainsPoint2f", CallingConvention = CallingConvention.Cdecl)]
         private static extern bool CGAL_ContainsPoint(Vector2f point);
+
+        [DllImport("CGALWrapper", EntryPoint = "Intersection2_BatchContainsPoints2f", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_BatchContainsPoints(Vector2f[] inPoints, int numPoints, [Out] int[] outIndices);
+
+        [DllImport("CGALWrapper", EntryPoint = "Intersection2_BatchContainsPointsMask2f", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_BatchContainsPointsMask(Vector2f[] inPoints, int numPoints, [Out] byte[] outMask);
+
+        [DllImport("CGALWrapper", EntryPoint = "Intersection2_BatchRaycast2f", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_BatchRaycast(Vector2f[] inOrigins, Vector2f[] inDirections, int numRays, float maxDistance, [Out] RayHit[] outHits);
+
+        [DllImport("CGALWrapper", EntryPoint = "Intersection2_BatchSegmentHits2f", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_BatchSegmentHits(Vector2f[] inStarts, Vector2f[] inEnds, int numSegments, [Out] RayHit[] outHits);
     }
 }
@@ -0,0 +1,87 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+
+using Common.Core.LinearAlgebra;
+using CGAL.Polygons.Descriptors;
+
+namespace CGAL.Polygons
+{
+
+    public static class PolygonOverlay2
+    {
+
+        private const int SUCCESS = 0;
+        private const int ERROR = 1;
+
+        //Overlays two layers of polygons in one arrangement. Each face of the
+        //result has a source pair giving the polygon of A and of B covering it,
+        //-1 if none, and its area. Polygons within a layer must not overlap.
+        public static List<Polygon2f> Overlay(IList<Polygon2f> A, IList<Polygon2f> B, out List<PolygonPair> sources, bool intersectionOnly = false)
+        {
+            CheckPolygons(A);
+            CheckPolygons(B);
+
+            PolygonBuffer2f bufferA = new PolygonBuffer2f(A);
+            PolygonBuffer2f bufferB = new PolygonBuffer2f(B);
+
+            CGAL_A_LoadPolygons(bufferA.Points, bufferA.RingSizes, bufferA.PolygonRings, bufferA.PolygonCount);
+            CGAL_B_LoadPolygons(bufferB.Points, bufferB.RingSizes, bufferB.PolygonRings, bufferB.PolygonCount);
+
+            PolygonBufferDescriptor descriptor;
+            if (CGAL_Compute(intersectionOnly, out descriptor) != SUCCESS)
+            {
+                CGAL_Clear();
+                throw new Exception("Error computing overlay.");
+            }
+
+            PolygonBuffer2f buffer = new PolygonBuffer2f(descriptor);
+            PolygonPair[] pairs = new PolygonPair[descriptor.Polygons];
+            CGAL_GetFaces(buffer.Points, buffer.RingSizes, buffer.PolygonRings, pairs);
+
+            CGAL_Clear();
+
+            sources = new List<PolygonPair>(pairs);
+            return buffer.ToPolygons();
+        }
+
+        private static void CheckPolygons(IList<Polygon2f> polygons)
+        {
+            for (int i = 0; i < polygons.Count; i++)
+            {
+                Polygon2f polygon = polygons[i];
+
+                if (!polygon.IsSimple)
+                    throw new ArgumentException("Polygon must be simple.");
+
+                if (!polygon.IsCCW)
+                    throw new ArgumentException("Polygon must have counter clock wise orientation. Reverse polygon.");
+
+                for (int j = 0; j < polygon.HoleCount; j++)
+                {
+                    if (!polygon.Holes[j].IsCW)
+                        throw new ArgumentException("Hole must have clock wise orientation.");
+                }
+            }
+        }
+
+        [DllImport("CGALWrapper", EntryPoint = "Overlay2_A_LoadPolygons2f", CallingConvention = CallingConvention.Cdecl)]
+        private static extern void CGAL_A_LoadPolygons(Vector2f[] inPoints, int[] inRingSizes, int[] inPolygonRings, int numPolygons);
+
+        [DllImport("CGALWrapper", EntryPoint = "Overlay2_B_LoadPolygons2f", CallingConvention = CallingConvention.Cdecl)]
+        private static extern void CGAL_B_LoadPolygons(Vector2f[] inPoints, int[] inRingSizes, int[] inPolygonRings, int numPolygons);
+
+        [DllImport("CGALWrapper", EntryPoint = "Overlay2_Clear", CallingConvention = CallingConvention.Cdecl)]
+        private static extern void CGAL_Clear();
+
+        [DllImport("CGALWrapper", EntryPoint = "Overlay2_Release", CallingConvention = CallingConvention.Cdecl)]
+        private static extern void CGAL_Release();
+
+        [DllImport("CGALWrapper", EntryPoint = "Overlay2_Compute", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_Compute(bool intersectionOnly, out PolygonBufferDescriptor descriptor);
+
+        [DllImport("CGALWrapper", EntryPoint = "Overlay2_GetFaces2f", CallingConvention = CallingConvention.Cdecl)]
+        private static extern void CGAL_GetFaces([Out] Vector2f[] outPoints, [Out] int[] outRingSizes, [Out] int[] outPolygonRings, [Out] PolygonPair[] outSources);
+
+    }
+}
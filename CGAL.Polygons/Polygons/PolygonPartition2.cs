@@ -3,17 +3,33 @@ using System.Collections.Generic;
 using System.Runtime.InteropServices;
 
 using Common.Core.LinearAlgebra;
+using CGAL.Polygons.Descriptors;
 
 namespace CGAL.Polygons
 {
 
-    public enum PARTITION_METHOD { APPROX, GREENE, YMONOTONE, OPTIMAL}
+    public enum PARTITION_METHOD { APPROX, GREENE, YMONOTONE, OPTIMAL, AUTO, TRIANGULATION }
 
     public static class PolygonPartition2
     {
 
         public static List<Polygon2f> Partition(Polygon2f polygon, PARTITION_METHOD method = PARTITION_METHOD.APPROX)
         {
+            PartitionReport report;
+            return Partition(polygon, method, out report);
+        }
+
+        public static List<Polygon2f> Partition(Polygon2f polygon, PARTITION_METHOD method, out PartitionReport report)
+        {
+
+            if (method == PARTITION_METHOD.TRIANGULATION)
+            {
+                PartitionReport[] reports;
+                List<Polygon2f> parts = BatchPartition(new Polygon2f[] { polygon }, method, out reports)[0];
+
+                report = reports[0];
+                return parts;
+            }
 
             if (!polygon.IsSimple)
                 throw new ArgumentException("Polygon must be simple.");
@@ -27,6 +43,7 @@ namespace CGAL.Polygons
             CGAL_LoadPoints(polygon.Positions, polygon.Positions.Length);
 
             int numPolygons = PerformPartition(method);
+            report = CGAL_GetReport();
 
             List<Polygon2f> partition = new List<Polygon2f>(numPolygons);
 
@@ -47,6 +64,108 @@ namespace CGAL.Polygons
             return partition;
         }
 
+        //Partitions every polygon in parallel. Result i holds the parts of polygon i
+        //and is empty if its partition failed.
+        public static List<List<Polygon2f>> BatchPartition(IList<Polygon2f> polygons, PARTITION_METHOD method = PARTITION_METHOD.APPROX)
+        {
+            PartitionReport[] reports;
+            return BatchPartition(polygons, method, out reports);
+        }
+
+        public static List<List<Polygon2f>> BatchPartition(IList<Polygon2f> polygons, PARTITION_METHOD method, out PartitionReport[] reports)
+        {
+            int numPoints = 0;
+            for (int i = 0; i < polygons.Count; i++)
+            {
+                Polygon2f polygon = polygons[i];
+
+                if (!polygon.IsSimple)
+                    throw new ArgumentException("Polygon must be simple.");
+
+                if (!polygon.IsCCW)
+                    throw new ArgumentException("Polygon must have counter clock wise orientation. Reverse polygon.");
+
+                if (polygon.HasHoles && method != PARTITION_METHOD.TRIANGULATION)
+                    throw new NotImplementedException("Polygon with holes only implemented for the triangulation method.");
+
+                for (int j = 0; j < polygon.HoleCount; j++)
+                {
+                    if (!polygon.Holes[j].IsCW)
+                        throw new ArgumentException("Hole must have clock wise orientation.");
+                }
+
+                numPoints += polygon.Positions.Length;
+            }
+
+            int numParts;
+
+            if (method == PARTITION_METHOD.TRIANGULATION)
+            {
+                PolygonBuffer2f buffer = new PolygonBuffer2f(polygons);
+                numParts = CGAL_TriangulationPartition(buffer.Points, buffer.RingSizes, buffer.PolygonRings, buffer.PolygonCount);
+            }
+            else
+            {
+                Vector2f[] points = new Vector2f[numPoints];
+                int[] sizes = new int[polygons.Count];
+
+                for (int i = 0, point = 0; i < polygons.Count; i++)
+                {
+                    Vector2f[] positions = polygons[i].Positions;
+                    Array.Copy(positions, 0, points, point, positions.Length);
+
+                    sizes[i] = positions.Length;
+                    point += positions.Length;
+                }
+
+                numParts = CGAL_BatchPartition(points, sizes, polygons.Count, (int)method);
+            }
+
+            Vector2f[] partPoints = new Vector2f[CGAL_BatchNumPoints()];
+            int[] polygonOffsets = new int[polygons.Count + 1];
+            int[] partOffsets = new int[numParts + 1];
+
+            CGAL_GetBatchPartition(partPoints, polygonOffsets, partOffsets);
+
+            reports = new PartitionReport[polygons.Count];
+            CGAL_GetBatchReports(reports);
+
+            CGAL_Clear();
+
+            List<List<Polygon2f>> partitions = new List<List<Polygon2f>>(polygons.Count);
+
+            for (int i = 0; i < polygons.Count; i++)
+            {
+                List<Polygon2f> partition = new List<Polygon2f>(polygonOffsets[i + 1] - polygonOffsets[i]);
+
+                for (int j = polygonOffsets[i]; j < polygonOffsets[i + 1]; j++)
+                {
+                    int size = partOffsets[j + 1] - partOffsets[j];
+                    Polygon2f poly = new Polygon2f(size);
+
+                    Array.Copy(partPoints, partOffsets[j], poly.Positions, 0, size);
+
+                    poly.CalculatePolygon();
+                    partition.Add(poly);
+                }
+
+                partitions.Add(partition);
+            }
+
+            return partitions;
+        }
+
+        //The auto method runs the optimal partition while its estimated cost of
+        //n^2 * (r + 1)^2, for n vertices and r reflex vertices, is within budget
+        //and the fallback method otherwise. A negative budget restores the default.
+        public static void SetAutoPartition(double budget, PARTITION_METHOD fallback = PARTITION_METHOD.GREENE)
+        {
+            if (fallback != PARTITION_METHOD.APPROX && fallback != PARTITION_METHOD.GREENE)
+                throw new ArgumentException("Fallback must be the approx or Greene method.");
+
+            CGAL_SetAutoPartition(budget, (int)fallback);
+        }
+
         private static int PerformPartition(PARTITION_METHOD method)
         {
 
@@ -69,6 +188,10 @@ namespace CGAL.Polygons
                 case PARTITION_METHOD.OPTIMAL:
                     numPolygons = CGAL_OptimalConvexPartition();
                     break;
+
+                case PARTITION_METHOD.AUTO:
+                    numPolygons = CGAL_AutoPartition();
+                    break;
             }
 
             return numPolygons;
@@ -95,10 +218,34 @@ namespace CGAL.Polygons
         [DllImport("CGALWrapper", EntryPoint = "Partition2_OptimalConvexPartition", CallingConvention = CallingConvention.Cdecl)]
         private static extern int CGAL_OptimalConvexPartition();
 
+        [DllImport("CGALWrapper", EntryPoint = "Partition2_AutoPartition", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_AutoPartition();
+
+        [DllImport("CGALWrapper", EntryPoint = "Partition2_SetAutoPartition", CallingConvention = CallingConvention.Cdecl)]
+        private static extern void CGAL_SetAutoPartition(double budget, int fallbackMethod);
+
+        [DllImport("CGALWrapper", EntryPoint = "Partition2_GetReport", CallingConvention = CallingConvention.Cdecl)]
+        private static extern PartitionReport CGAL_GetReport();
+
         [DllImport("CGALWrapper", EntryPoint = "Partition2_GetPolygonSize", CallingConvention = CallingConvention.Cdecl)]
         private static extern int CGAL_GetPolygonSize(int i);
 
         [DllImport("CGALWrapper", EntryPoint = "Partition2_GetPolygonPoint2f", CallingConvention = CallingConvention.Cdecl)]
         private static extern Vector2f CGAL_GetPolygonVector2f(int i, int j);
+
+        [DllImport("CGALWrapper", EntryPoint = "Partition2_BatchPartition2f", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_BatchPartition(Vector2f[] inPoints, int[] inSizes, int numPolygons, int method);
+
+        [DllImport("CGALWrapper", EntryPoint = "Partition2_TriangulationPartition2f", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_TriangulationPartition(Vector2f[] inPoints, int[] inRingSizes, int[] inPolygonRings, int numPolygons);
+
+        [DllImport("CGALWrapper", EntryPoint = "Partition2_BatchNumPoints", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_BatchNumPoints();
+
+        [DllImport("CGALWrapper", EntryPoint = "Partition2_GetBatchPartition2f", CallingConvention = CallingConvention.Cdecl)]
+        private static extern void CGAL_GetBatchPartition([Out] Vector2f[] outPoints, [Out] int[] outPolygonOffsets, [Out] int[] outPartOffsets);
+
+        [DllImport("CGALWrapper", EntryPoint = "Partition2_GetBatchReports", CallingConvention = CallingConvention.Cdecl)]
+        private static extern void CGAL_GetBatchReports([Out] PartitionReport[] outReports);
     }
 }
@@ -0,0 +1,202 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+
+using Common.Core.LinearAlgebra;
+
+namespace CGAL.Polygons
+{
+    public static class PolygonSet2
+    {
+
+        private const int SUCCESS = 0;
+        private const int ERROR = 1;
+
+        public static int Count { get { return CGAL_NumPolygons(); } }
+
+        public static void Insert(Polygon2f polygon)
+        {
+            PerformOperation(polygon, CGAL_Insert);
+        }
+
+        public static void Join(Polygon2f polygon)
+        {
+            PerformOperation(polygon, CGAL_Join);
+        }
+
+        public static void Difference(Polygon2f polygon)
+        {
+            PerformOperation(polygon, CGAL_Difference);
+        }
+
+        public static void Intersect(Polygon2f polygon)
+        {
+            PerformOperation(polygon, CGAL_Intersect);
+        }
+
+        public static void Clear()
+        {
+            CGAL_Clear();
+        }
+
+        public static void Release()
+        {
+            CGAL_Release();
+        }
+
+        public static Dictionary<int, Polygon2f> GetPolygons()
+        {
+            int numPolygons = CGAL_NumPolygons();
+            Dictionary<int, Polygon2f> polygons = new Dictionary<int, Polygon2f>(numPolygons);
+
+            int[] ids = new int[numPolygons];
+            CGAL_GetPolygonIds(ids);
+
+            foreach (int id in ids)
+                polygons.Add(id, CreatePolygon(id));
+
+            return polygons;
+        }
+
+        public static void GetChanges(List<int> removed, Dictionary<int, Polygon2f> added)
+        {
+            int[] removedIds = new int[CGAL_NumRemoved()];
+            CGAL_GetRemovedIds(removedIds);
+            removed.AddRange(removedIds);
+
+            int[] addedIds = new int[CGAL_NumAdded()];
+            CGAL_GetAddedIds(addedIds);
+
+            foreach (int id in addedIds)
+                added.Add(id, CreatePolygon(id));
+
+            CGAL_ClearChanges();
+        }
+
+        private static void PerformOperation(Polygon2f polygon, Func<int> func)
+        {
+            if (!polygon.IsSimple)
+                throw new ArgumentException("Polygon must be simple.");
+
+            if (!polygon.IsCCW)
+                throw new ArgumentException("Polygon must have counter clock wise orientation. Reverse polygon.");
+
+            CGAL_LoadBrush(polygon.Positions, polygon.Positions.Length);
+            AddHoles(polygon);
+
+            if (func() != SUCCESS)
+                throw new Exception("Error performing polygon set operation.");
+        }
+
+        private static void AddHoles(Polygon2f polygon)
+        {
+            if (!polygon.HasHoles) return;
+
+            int holes = polygon.Holes.Count;
+            for (int i = 0; i < holes; i++)
+            {
+                Polygon2f hole = polygon.Holes[i];
+
+                if (!hole.IsSimple)
+                    throw new ArgumentException("Hole must be simple.");
+
+                if (!hole.IsCW)
+                    throw new ArgumentException("Hole must have clock wise orientation.");
+
+                CGAL_AddBrushHole(hole.Positions, hole.Positions.Length);
+            }
+        }
+
+        private static Polygon2f CreatePolygon(int id)
+        {
+            if (!CGAL_PointToPolygon(id))
+                throw new ArgumentException("Polygon id not in set.");
+
+            int numPoints = CGAL_NumPolygonPoints();
+            int numHoles = CGAL_NumPolygonHoles();
+            Polygon2f polygon = new Polygon2f(numPoints);
+
+            for (int i = 0; i < numPoints; i++)
+                polygon.Positions[i] = CGAL_GetPolygonPoint2f(i);
+
+            for (int i = 0; i < numHoles; i++)
+            {
+                int holePoints = CGAL_NumHolePoints(i);
+                Polygon2f hole = new Polygon2f(holePoints);
+
+                for (int j = 0; j < holePoints; j++)
+                    hole.Positions[j] = CGAL_GetHolePoint2f(i, j);
+
+                polygon.AddHole(hole);
+            }
+
+            polygon.CalculatePolygon();
+
+            return polygon;
+        }
+
+        [DllImport("CGALWrapper", EntryPoint = "PolygonSet2_LoadBrush2f", CallingConvention = CallingConvention.Cdecl)]
+        private static extern void CGAL_LoadBrush(Vector2f[] inPoints, int inSize);
+
+        [DllImport("CGALWrapper", EntryPoint = "PolygonSet2_AddBrushHole2f", CallingConvention = CallingConvention.Cdecl)]
+        private static extern void CGAL_AddBrushHole(Vector2f[] inPoints, int inSize);
+
+        [DllImport("CGALWrapper", EntryPoint = "PolygonSet2_Clear", CallingConvention = CallingConvention.Cdecl)]
+        private static extern void CGAL_Clear();
+
+        [DllImport("CGALWrapper", EntryPoint = "PolygonSet2_Release", CallingConvention = CallingConvention.Cdecl)]
+        private static extern void CGAL_Release();
+
+        [DllImport("CGALWrapper", EntryPoint = "PolygonSet2_Insert", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_Insert();
+
+        [DllImport("CGALWrapper", EntryPoint = "PolygonSet2_Join", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_Join();
+
+        [DllImport("CGALWrapper", EntryPoint = "PolygonSet2_Difference", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_Difference();
+
+        [DllImport("CGALWrapper", EntryPoint = "PolygonSet2_Intersect", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_Intersect();
+
+        [DllImport("CGALWrapper", EntryPoint = "PolygonSet2_NumPolygons", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_NumPolygons();
+
+        [DllImport("CGALWrapper", EntryPoint = "PolygonSet2_GetPolygonIds", CallingConvention = CallingConvention.Cdecl)]
+        private static extern void CGAL_GetPolygonIds([Out] int[] outIds);
+
+        [DllImport("CGALWrapper", EntryPoint = "PolygonSet2_NumAdded", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_NumAdded();
+
+        [DllImport("CGALWrapper", EntryPoint = "PolygonSet2_GetAddedIds", CallingConvention = CallingConvention.Cdecl)]
+        private static extern void CGAL_GetAddedIds([Out] int[] outIds);
+
+        [DllImport("CGALWrapper", EntryPoint = "PolygonSet2_NumRemoved", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_NumRemoved();
+
+        [DllImport("CGALWrapper", EntryPoint = "PolygonSet2_GetRemovedIds", CallingConvention = CallingConvention.Cdecl)]
+        private static extern void CGAL_GetRemovedIds([Out] int[] outIds);
+
+        [DllImport("CGALWrapper", EntryPoint = "PolygonSet2_ClearChanges", CallingConvention = CallingConvention.Cdecl)]
+        private static extern void CGAL_ClearChanges();
+
+        [DllImport("CGALWrapper", EntryPoint = "PolygonSet2_PointToPolygon", CallingConvention = CallingConvention.Cdecl)]
+        private static extern bool CGAL_PointToPolygon(int id);
+
+        [DllImport("CGALWrapper", EntryPoint = "PolygonSet2_NumPolygonPoints", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_NumPolygonPoints();
+
+        [DllImport("CGALWrapper", EntryPoint = "PolygonSet2_NumPolygonHoles", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_NumPolygonHoles();
+
+        [DllImport("CGALWrapper", EntryPoint = "PolygonSet2_NumHolePoints", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_NumHolePoints(int holeIndex);
+
+        [DllImport("CGALWrapper", EntryPoint = "PolygonSet2_GetPolygonPoint2f", CallingConvention = CallingConvention.Cdecl)]
+        private static extern Vector2f CGAL_GetPolygonPoint2f(int pointIndex);
+
+        [DllImport("CGALWrapper", EntryPoint = "PolygonSet2_GetHolePoint2f", CallingConvention = CallingConvention.Cdecl)]
+        private static extern Vector2f CGAL_GetHolePoint2f(int holeIndex, int pointIndex);
+
+    }
+}
@@ -3,15 +3,21 @@ using System.Collections.Generic;
 using System.Runtime.InteropServices;
 
 using Common.Core.LinearAlgebra;
+using CGAL.Polygons.Descriptors;
 
 namespace CGAL.Polygons
 {
 
     public enum SIMPLIFY_METHOD {  SQUARE_DIST, SCALED_SQUARE_DIST };
 
+    public enum SIMPLIFY_STOP { COUNT_RATIO, COST, COUNT };
+
     public static class PolygonSimplify2
     {
 
+        private const int SUCCESS = 0;
+        private const int ERROR = 1;
+
         public static Polygon2f Simplify(Polygon2f polygon, float threshold, SIMPLIFY_METHOD method = SIMPLIFY_METHOD.SQUARE_DIST)
         {
 
@@ -46,6 +52,215 @@ namespace CGAL.Polygons
             }
         }
 
+        //Removes vertices until the cheapest removal left costs more than maxCost.
+        public static Polygon2f SimplifyToCost(Polygon2f polygon, float maxCost, SIMPLIFY_METHOD method = SIMPLIFY_METHOD.SQUARE_DIST)
+        {
+            CheckPolygon(polygon);
+
+            if (polygon.VerticesCount < 3)
+                return CopyPolygon(polygon);
+
+            CGAL_LoadPoints(polygon.Positions, polygon.Positions.Length);
+
+            int size = CGAL_CostThresholdSimplify(Math.Max(0.0f, maxCost), (int)method);
+
+            return GetSimplified(size);
+        }
+
+        //Removes vertices until no more than count are left.
+        public static Polygon2f SimplifyToCount(Polygon2f polygon, int count, SIMPLIFY_METHOD method = SIMPLIFY_METHOD.SQUARE_DIST)
+        {
+            CheckPolygon(polygon);
+
+            if (polygon.VerticesCount < 3)
+                return CopyPolygon(polygon);
+
+            CGAL_LoadPoints(polygon.Positions, polygon.Positions.Length);
+
+            int size = CGAL_CountThresholdSimplify(Math.Max(3, count), (int)method);
+
+            return GetSimplified(size);
+        }
+
+        //Simplifies once and returns the result for each threshold, which is a
+        //count ratio, cost or vertex count depending on the stop criterion.
+        public static List<Polygon2f> SimplifyMany(Polygon2f polygon, float[] thresholds, SIMPLIFY_STOP stop, SIMPLIFY_METHOD method = SIMPLIFY_METHOD.SQUARE_DIST)
+        {
+            CheckPolygon(polygon);
+
+            List<Polygon2f> results = new List<Polygon2f>(thresholds.Length);
+
+            if (polygon.VerticesCount < 3)
+            {
+                for (int i = 0; i < thresholds.Length; i++)
+                    results.Add(CopyPolygon(polygon));
+
+                return results;
+            }
+
+            CGAL_LoadPoints(polygon.Positions, polygon.Positions.Length);
+
+            int[] counts = new int[thresholds.Length];
+            if (CGAL_MultiThresholdSimplify(thresholds, thresholds.Length, (int)stop, (int)method, counts) != SUCCESS)
+            {
+                CGAL_Clear();
+                throw new Exception("Error simplifying polygon.");
+            }
+
+            int total = 0;
+            for (int i = 0; i < counts.Length; i++)
+                total += counts[i];
+
+            Vector2f[] points = new Vector2f[total];
+            CGAL_GetMultiThreshold(points);
+
+            CGAL_Clear();
+
+            int offset = 0;
+            for (int i = 0; i < counts.Length; i++)
+            {
+                Polygon2f simplified = new Polygon2f(counts[i]);
+                Array.Copy(points, offset, simplified.Positions, 0, counts[i]);
+                simplified.CalculatePolygon();
+
+                results.Add(simplified);
+                offset += counts[i];
+            }
+
+            return results;
+        }
+
+        public static ProgressivePolygon2f SimplifyProgressive(Polygon2f polygon, SIMPLIFY_METHOD method = SIMPLIFY_METHOD.SQUARE_DIST)
+        {
+
+            if (!polygon.IsSimple)
+                throw new ArgumentException("Polygon must be simple.");
+
+            if (polygon.HasHoles)
+                throw new NotImplementedException("Polygon with holes not implemented.");
+
+            Vector2f[] positions = polygon.Positions.Clone() as Vector2f[];
+
+            if (polygon.VerticesCount < 3)
+                return new ProgressivePolygon2f(positions, new int[0], new float[0], new float[0], new int[0]);
+
+            CGAL_LoadPoints(positions, positions.Length);
+
+            int count = CGAL_ProgressiveSimplify((int)method);
+
+            int[] order = new int[count];
+            float[] costs = new float[count];
+            CGAL_GetRemovalOrder(order, costs);
+
+            int offers = CGAL_GetOfferCount();
+
+            float[] offeredCosts = new float[offers];
+            int[] offeredRemovals = new int[offers];
+            CGAL_GetOffers(offeredCosts, offeredRemovals);
+
+            CGAL_Clear();
+
+            return new ProgressivePolygon2f(positions, order, costs, offeredCosts, offeredRemovals);
+        }
+
+        //Polygons sharing boundaries are simplified together so the shared
+        //edges stay identical. Holes are supported.
+        public static List<Polygon2f> SimplifyBatch(IList<Polygon2f> polygons, float threshold, SIMPLIFY_METHOD method = SIMPLIFY_METHOD.SQUARE_DIST)
+        {
+            for (int i = 0; i < polygons.Count; i++)
+            {
+                if (!polygons[i].IsSimple)
+                    throw new ArgumentException("Polygon must be simple.");
+            }
+
+            if (threshold < 0.0f) threshold = 0.0f;
+            if (threshold > 1.0f) threshold = 1.0f;
+
+            PolygonBuffer2f input = new PolygonBuffer2f(polygons);
+
+            if (CGAL_BatchSimplify(input.Points, input.RingSizes, input.PolygonRings, input.PolygonCount, threshold, (int)method) != SUCCESS)
+                throw new Exception("Error simplifying polygons.");
+
+            PolygonBuffer2f output = new PolygonBuffer2f(CGAL_GetBatchDescriptor());
+            CGAL_GetBatch(output.Points, output.RingSizes, output.PolygonRings);
+
+            CGAL_Clear();
+
+            return output.ToPolygons();
+        }
+
+        //Starts simplifying an open polyline pushed in chunks. Only a window of
+        //points is held natively so the polyline can be of any length.
+        public static void BeginStream(float threshold, int windowSize = 4096, SIMPLIFY_METHOD method = SIMPLIFY_METHOD.SQUARE_DIST)
+        {
+            if (threshold < 0.0f) threshold = 0.0f;
+            if (threshold > 1.0f) threshold = 1.0f;
+
+            CGAL_BeginStream((int)method, threshold, windowSize);
+        }
+
+        //Pushes the next points of the polyline and adds any simplified
+        //points that are ready to the output.
+        public static void PushStream(Vector2f[] points, List<Vector2f> output)
+        {
+            int count = CGAL_PushStream(points, points.Length);
+
+            if (count < 0)
+                throw new Exception("Error simplifying polyline.");
+
+            CollectStream(count, output);
+        }
+
+        //Adds the rest of the simplified polyline to the output.
+        public static void EndStream(List<Vector2f> output)
+        {
+            int count = CGAL_EndStream();
+
+            if (count < 0)
+                throw new Exception("Error simplifying polyline.");
+
+            CollectStream(count, output);
+        }
+
+        private static void CollectStream(int count, List<Vector2f> output)
+        {
+            if (count == 0) return;
+
+            Vector2f[] points = new Vector2f[count];
+            CGAL_GetStream(points);
+            output.AddRange(points);
+        }
+
+        private static void CheckPolygon(Polygon2f polygon)
+        {
+            if (!polygon.IsSimple)
+                throw new ArgumentException("Polygon must be simple.");
+
+            if (polygon.HasHoles)
+                throw new NotImplementedException("Polygon with holes not implemented.");
+        }
+
+        private static Polygon2f CopyPolygon(Polygon2f polygon)
+        {
+            Polygon2f copy = new Polygon2f(polygon.Positions);
+            copy.CalculatePolygon();
+            return copy;
+        }
+
+        private static Polygon2f GetSimplified(int size)
+        {
+            Polygon2f simplified = new Polygon2f(size);
+
+            for (int i = 0; i < size; i++)
+                simplified.Positions[i] = CGAL_GetSimplifiedVector2f(i);
+
+            simplified.CalculatePolygon();
+
+            CGAL_Clear();
+
+            return simplified;
+        }
+
         private static int PerformSimplification(float threshold, SIMPLIFY_METHOD method)
         {
             int size = 0;
@@ -82,7 +297,52 @@ namespace CGAL.Polygons
         [DllImport("CGALWrapper", EntryPoint = "Simplify2_ScaledSquareDistCostSimplify", CallingConvention = CallingConvention.Cdecl)]
         private static extern int CGAL_ScaledSquareDistCostSimplify(float threshold);
 
+        [DllImport("CGALWrapper", EntryPoint = "Simplify2_CostThresholdSimplify", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_CostThresholdSimplify(float threshold, int method);
+
+        [DllImport("CGALWrapper", EntryPoint = "Simplify2_CountThresholdSimplify", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_CountThresholdSimplify(int count, int method);
+
         [DllImport("CGALWrapper", EntryPoint = "Simplify2_GetSimplifiedPoint2f", CallingConvention = CallingConvention.Cdecl)]
         private static extern Vector2f CGAL_GetSimplifiedVector2f(int i);
+
+        [DllImport("CGALWrapper", EntryPoint = "Simplify2_ProgressiveSimplify", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_ProgressiveSimplify(int method);
+
+        [DllImport("CGALWrapper", EntryPoint = "Simplify2_GetRemovalOrder", CallingConvention = CallingConvention.Cdecl)]
+        private static extern void CGAL_GetRemovalOrder([Out] int[] outIndices, [Out] float[] outCosts);
+
+        [DllImport("CGALWrapper", EntryPoint = "Simplify2_GetOfferCount", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_GetOfferCount();
+
+        [DllImport("CGALWrapper", EntryPoint = "Simplify2_GetOffers", CallingConvention = CallingConvention.Cdecl)]
+        private static extern void CGAL_GetOffers([Out] float[] outCosts, [Out] int[] outRemovals);
+
+        [DllImport("CGALWrapper", EntryPoint = "Simplify2_BatchSimplify2f", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_BatchSimplify(Vector2f[] inPoints, int[] inRingSizes, int[] inPolygonRings, int numPolygons, float threshold, int method);
+
+        [DllImport("CGALWrapper", EntryPoint = "Simplify2_GetBatchDescriptor", CallingConvention = CallingConvention.Cdecl)]
+        private static extern PolygonBufferDescriptor CGAL_GetBatchDescriptor();
+
+        [DllImport("CGALWrapper", EntryPoint = "Simplify2_GetBatch2f", CallingConvention = CallingConvention.Cdecl)]
+        private static extern void CGAL_GetBatch([Out] Vector2f[] outPoints, [Out] int[] outRingSizes, [Out] int[] outPolygonRings);
+
+        [DllImport("CGALWrapper", EntryPoint = "Simplify2_BeginStream", CallingConvention = CallingConvention.Cdecl)]
+        private static extern void CGAL_BeginStream(int method, float threshold, int windowSize);
+
+        [DllImport("CGALWrapper", EntryPoint = "Simplify2_PushStream2f", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_PushStream(Vector2f[] inPoints, int inSize);
+
+        [DllImport("CGALWrapper", EntryPoint = "Simplify2_EndStream", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_EndStream();
+
+        [DllImport("CGALWrapper", EntryPoint = "Simplify2_GetStream2f", CallingConvention = CallingConvention.Cdecl)]
+        private static extern void CGAL_GetStream([Out] Vector2f[] outPoints);
+
+        [DllImport("CGALWrapper", EntryPoint = "Simplify2_MultiThresholdSimplify", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_MultiThresholdSimplify(float[] thresholds, int numThresholds, int criterion, int method, [Out] int[] outCounts);
+
+        [DllImport("CGALWrapper", EntryPoint = "Simplify2_GetMultiThreshold2f", CallingConvention = CallingConvention.Cdecl)]
+        private static extern void CGAL_GetMultiThreshold([Out] Vector2f[] outPoints);
     }
 }
@@ -5,6 +5,7 @@ using System.Runtime.InteropServices;
 using Common.Core.LinearAlgebra;
 using CGAL.Meshes.Constructors;
 using CGAL.Meshes.Descriptors;
+using CGAL.Polygons.Descriptors;
 
 namespace CGAL.Polygons
 {
@@ -36,6 +37,56 @@ namespace CGAL.Polygons
             CGAL_Clear();
         }
 
+        public static Skeleton2f CreateInteriorSkeleton(Polygon2f polygon, bool includeBorder = false)
+        {
+
+            if (!polygon.IsSimple)
+                throw new ArgumentException("Polygon must be simple.");
+
+            if (!polygon.IsCCW)
+                throw new ArgumentException("Polygon must have counter clock wise orientation.");
+
+            CGAL_LoadPoints(polygon.Positions, polygon.Positions.Length);
+            AddHoles(polygon);
+
+            MeshDescriptor descriptor;
+            if (CGAL_CreateInteriorSkeleton(includeBorder, out descriptor) != SUCCESS)
+            {
+                CGAL_Clear();
+                throw new Exception("Error creating interior skeleton.");
+            }
+
+            Skeleton2f skeleton = GetSkeleton(descriptor);
+
+            CGAL_Clear();
+
+            return skeleton;
+        }
+
+        //Approximates the medial axis from boundary samples no more than tolerance
+        //apart, for polygons too large or noisy for the exact skeleton. Branches
+        //between samples closer than pruneLength are dropped. Zero uses twice
+        //the tolerance. Times are the distance to the boundary.
+        public static Skeleton2f CreateApproximateMedialAxis(Polygon2f polygon, float tolerance, float pruneLength = 0)
+        {
+            MeshDescriptor descriptor = MedialAxis(polygon, tolerance, pruneLength);
+
+            Skeleton2f skeleton = GetSkeleton(descriptor);
+
+            CGAL_Clear();
+
+            return skeleton;
+        }
+
+        public static void CreateApproximateMedialAxis<MESH>(Polygon2f polygon, IMeshConstructor<MESH> constructor, float tolerance, float pruneLength = 0)
+        {
+            MeshDescriptor descriptor = MedialAxis(polygon, tolerance, pruneLength);
+
+            CreateLine(constructor, descriptor);
+
+            CGAL_Clear();
+        }
+
         public static void CreateExteriorSkeleton<MESH>(Polygon2f polygon, IMeshConstructor<MESH> constructor, float maxOffset, bool includeBorder = true)
         {
 
@@ -81,6 +132,184 @@ namespace CGAL.Polygons
             return polygons;
         }
 
+        //Creates the offset polygons for each distance from one skeleton.
+        public static List<Polygon2f>[] CreateOffsets(Polygon2f polygon, float[] offsets, bool exterior = false)
+        {
+
+            if (!polygon.IsSimple)
+                throw new ArgumentException("Polygon must be simple.");
+
+            if (!polygon.IsCCW)
+                throw new ArgumentException("Polygon must have counter clock wise orientation.");
+
+            CGAL_LoadPoints(polygon.Positions, polygon.Positions.Length);
+            AddHoles(polygon);
+
+            double[] distances = new double[offsets.Length];
+            for (int i = 0; i < offsets.Length; i++)
+                distances[i] = offsets[i];
+
+            PolygonBufferDescriptor descriptor;
+            if (CGAL_CreateOffsets(distances, distances.Length, exterior, out descriptor) != SUCCESS)
+            {
+                CGAL_Clear();
+                throw new Exception("Error creating offsets.");
+            }
+
+            PolygonBuffer2f buffer = new PolygonBuffer2f(descriptor);
+            int[] indices = new int[descriptor.Polygons];
+            CGAL_GetOffsets(buffer.Points, buffer.RingSizes, buffer.PolygonRings, indices);
+
+            CGAL_Clear();
+
+            List<Polygon2f>[] results = new List<Polygon2f>[offsets.Length];
+            for (int i = 0; i < offsets.Length; i++)
+                results[i] = new List<Polygon2f>();
+
+            List<Polygon2f> polygons = buffer.ToPolygons();
+            for (int i = 0; i < polygons.Count; i++)
+                results[indices[i]].Add(polygons[i]);
+
+            return results;
+        }
+
+        //Creates the skeleton of each polygon on a worker thread. A polygon
+        //whose skeleton fails has an empty skeleton.
+        public static Skeleton2f[] CreateSkeletons(IList<Polygon2f> polygons, bool exterior = false, float maxOffset = 0, bool includeBorder = false)
+        {
+            CheckPolygons(polygons);
+
+            PolygonBuffer2f input = new PolygonBuffer2f(polygons);
+
+            MeshDescriptor descriptor;
+            if (CGAL_BatchSkeleton(input.Points, input.RingSizes, input.PolygonRings, input.PolygonCount, exterior, maxOffset, includeBorder, out descriptor) != SUCCESS)
+            {
+                CGAL_Clear();
+                throw new Exception("Error creating skeletons.");
+            }
+
+            Skeleton2f all = GetSkeleton(descriptor);
+
+            int count = polygons.Count;
+            int[] vertexOffsets = new int[count + 1];
+            int[] edgeOffsets = new int[count + 1];
+            int[] connectionOffsets = new int[count + 1];
+            CGAL_GetBatchSkeletonOffsets(vertexOffsets, edgeOffsets, connectionOffsets);
+
+            CGAL_Clear();
+
+            Skeleton2f[] skeletons = new Skeleton2f[count];
+            for (int i = 0; i < count; i++)
+            {
+                int v0 = vertexOffsets[i], numVertices = vertexOffsets[i + 1] - v0;
+                int e0 = edgeOffsets[i], numEdges = edgeOffsets[i + 1] - e0;
+                int c0 = connectionOffsets[i], numConnections = connectionOffsets[i + 1] - c0;
+
+                Vector2f[] points = new Vector2f[numVertices];
+                float[] times = new float[numVertices];
+                bool[] isContour = new bool[numVertices];
+                EdgeIndex[] edges = new EdgeIndex[numEdges];
+                EdgeConnection[] connections = new EdgeConnection[numConnections];
+
+                Array.Copy(all.Points, v0, points, 0, numVertices);
+                Array.Copy(all.Times, v0, times, 0, numVertices);
+                Array.Copy(all.IsContour, v0, isContour, 0, numVertices);
+                Array.Copy(all.Edges, e0, edges, 0, numEdges);
+                Array.Copy(all.Connections, c0, connections, 0, numConnections);
+
+                skeletons[i] = new Skeleton2f(points, edges, connections, times, isContour);
+            }
+
+            return skeletons;
+        }
+
+        //Creates the offset polygons for each distance of each polygon on a worker
+        //thread. The result is indexed by polygon then distance.
+        public static List<Polygon2f>[][] CreateOffsets(IList<Polygon2f> polygons, float[] offsets, bool exterior = false)
+        {
+            CheckPolygons(polygons);
+
+            PolygonBuffer2f input = new PolygonBuffer2f(polygons);
+
+            double[] distances = new double[offsets.Length];
+            for (int i = 0; i < offsets.Length; i++)
+                distances[i] = offsets[i];
+
+            PolygonBufferDescriptor descriptor;
+            if (CGAL_BatchOffsets(input.Points, input.RingSizes, input.PolygonRings, input.PolygonCount, distances, distances.Length, exterior, out descriptor) != SUCCESS)
+            {
+                CGAL_Clear();
+                throw new Exception("Error creating offsets.");
+            }
+
+            PolygonBuffer2f buffer = new PolygonBuffer2f(descriptor);
+            int[] indices = new int[descriptor.Polygons];
+            int[] polygonOffsets = new int[polygons.Count + 1];
+            CGAL_GetBatchOffsets(buffer.Points, buffer.RingSizes, buffer.PolygonRings, indices, polygonOffsets);
+
+            CGAL_Clear();
+
+            List<Polygon2f> all = buffer.ToPolygons();
+
+            List<Polygon2f>[][] results = new List<Polygon2f>[polygons.Count][];
+            for (int i = 0; i < polygons.Count; i++)
+            {
+                results[i] = new List<Polygon2f>[offsets.Length];
+                for (int j = 0; j < offsets.Length; j++)
+                    results[i][j] = new List<Polygon2f>();
+
+                for (int j = polygonOffsets[i]; j < polygonOffsets[i + 1]; j++)
+                    results[i][indices[j]].Add(all[j]);
+            }
+
+            return results;
+        }
+
+        private static MeshDescriptor MedialAxis(Polygon2f polygon, float tolerance, float pruneLength)
+        {
+
+            if (!polygon.IsSimple)
+                throw new ArgumentException("Polygon must be simple.");
+
+            if (tolerance <= 0)
+                throw new ArgumentException("Tolerance must be positive.");
+
+            CGAL_LoadPoints(polygon.Positions, polygon.Positions.Length);
+            AddHoles(polygon);
+
+            MeshDescriptor descriptor;
+            if (CGAL_CreateApproximateMedialAxis(tolerance, pruneLength, out descriptor) != SUCCESS)
+            {
+                CGAL_Clear();
+                throw new Exception("Error creating medial axis.");
+            }
+
+            return descriptor;
+        }
+
+        private static void CheckPolygons(IList<Polygon2f> polygons)
+        {
+            for (int i = 0; i < polygons.Count; i++)
+            {
+                Polygon2f polygon = polygons[i];
+
+                if (!polygon.IsSimple)
+                    throw new ArgumentException("Polygon must be simple.");
+
+                if (!polygon.IsCCW)
+                    throw new ArgumentException("Polygon must have counter clock wise orientation.");
+
+                for (int j = 0; j < polygon.HoleCount; j++)
+                {
+                    if (!polygon.Holes[j].IsSimple)
+                        throw new ArgumentException("Hole must be simple.");
+
+                    if (!polygon.Holes[j].IsCW)
+                        throw new ArgumentException("Hole must have clock wise orientation.");
+                }
+            }
+        }
+
         private static void AddHoles(Polygon2f polygon)
         {
             if (!polygon.HasHoles) return;
@@ -103,27 +332,36 @@ namespace CGAL.Polygons
         private static void CreateLine<MESH>(IMeshConstructor<MESH> constructor, MeshDescriptor des)
         {
 
+            Skeleton2f skeleton = GetSkeleton(des);
+
             constructor.PushEdgeMesh(des.Vertices, des.Edges);
 
             for (int i = 0; i < des.Vertices; i++)
-            {
-                Vector2f v = CGAL_GetSkeletonPoint(i);
-                constructor.AddVertex(v);
-            }
+                constructor.AddVertex(skeleton.Points[i]);
 
             for (int i = 0; i < des.Edges; i++)
-            {
-                EdgeIndex edge = CGAL_GetSkeletonEdge(i);
-                constructor.AddEdge(edge);
-            }
+                constructor.AddEdge(skeleton.Edges[i]);
 
-            int numConnections = CGAL_NumEdgeConnection();
-            for (int i = 0; i < numConnections; i++)
-            {
-                EdgeConnection con = CGAL_GetEdgeConnection(i);
-                constructor.AddEdgeConnection(con);
-            }
+            for (int i = 0; i < skeleton.Connections.Length; i++)
+                constructor.AddEdgeConnection(skeleton.Connections[i]);
+
+        }
+
+        private static Skeleton2f GetSkeleton(MeshDescriptor des)
+        {
+            Vector2f[] points = new Vector2f[des.Vertices];
+            EdgeIndex[] edges = new EdgeIndex[des.Edges];
+            EdgeConnection[] connections = new EdgeConnection[CGAL_NumEdgeConnection()];
+            float[] times = new float[des.Vertices];
+            byte[] contour = new byte[des.Vertices];
+
+            CGAL_GetSkeleton(points, edges, connections, times, contour);
+
+            bool[] isContour = new bool[des.Vertices];
+            for (int i = 0; i < des.Vertices; i++)
+                isContour[i] = contour[i] != 0;
 
+            return new Skeleton2f(points, edges, connections, times, isContour);
         }
 
         private static Polygon2f CreatePolygon(int index)
@@ -158,6 +396,9 @@ namespace CGAL.Polygons
         [DllImport("CGALWrapper", EntryPoint = "Skeleton2_CreateExteriorSkeleton", CallingConvention = CallingConvention.Cdecl)]
         private static extern int CGAL_CreateExteriorSkeleton(double maxOffset, bool includeBorder, out MeshDescriptor descriptor);
 
+        [DllImport("CGALWrapper", EntryPoint = "Skeleton2_CreateApproximateMedialAxis", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_CreateApproximateMedialAxis(double tolerance, double pruneLength, out MeshDescriptor descriptor);
+
         [DllImport("CGALWrapper", EntryPoint = "Skeleton2_CreateInteriorOffset", CallingConvention = CallingConvention.Cdecl)]
         private static extern int CGAL_CreateInteriorOffset(double offset);
 
@@ -173,11 +414,32 @@ namespace CGAL.Polygons
         [DllImport("CGALWrapper", EntryPoint = "Skeleton2_GetEdgeConnection", CallingConvention = CallingConvention.Cdecl)]
         private static extern EdgeConnection CGAL_GetEdgeConnection(int i);
 
+        [DllImport("CGALWrapper", EntryPoint = "Skeleton2_GetSkeleton2f", CallingConvention = CallingConvention.Cdecl)]
+        private static extern void CGAL_GetSkeleton([Out] Vector2f[] outPoints, [Out] EdgeIndex[] outEdges, [Out] EdgeConnection[] outConnections, [Out] float[] outTimes, [Out] byte[] outContour);
+
         [DllImport("CGALWrapper", EntryPoint = "Skeleton2_NumPolygonPoints", CallingConvention = CallingConvention.Cdecl)]
         private static extern int CGAL_NumPolygonPoints(int polygonIndex);
 
         [DllImport("CGALWrapper", EntryPoint = "Skeleton2_GetPolygonPoint2f", CallingConvention = CallingConvention.Cdecl)]
         private static extern Vector2f CGAL_GetPolygonPoint2f(int polygonIndex, int pointIndex);
 
+        [DllImport("CGALWrapper", EntryPoint = "Skeleton2_CreateOffsets", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_CreateOffsets(double[] inOffsets, int numOffsets, bool exterior, out PolygonBufferDescriptor descriptor);
+
+        [DllImport("CGALWrapper", EntryPoint = "Skeleton2_GetOffsets2f", CallingConvention = CallingConvention.Cdecl)]
+        private static extern void CGAL_GetOffsets([Out] Vector2f[] outPoints, [Out] int[] outRingSizes, [Out] int[] outPolygonRings, [Out] int[] outOffsetIndices);
+
+        [DllImport("CGALWrapper", EntryPoint = "Skeleton2_BatchSkeleton2f", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_BatchSkeleton(Vector2f[] inPoints, int[] inRingSizes, int[] inPolygonRings, int numPolygons, bool exterior, double maxOffset, bool includeBorder, out MeshDescriptor descriptor);
+
+        [DllImport("CGALWrapper", EntryPoint = "Skeleton2_GetBatchSkeletonOffsets", CallingConvention = CallingConvention.Cdecl)]
+        private static extern void CGAL_GetBatchSkeletonOffsets([Out] int[] outVertexOffsets, [Out] int[] outEdgeOffsets, [Out] int[] outConnectionOffsets);
+
+        [DllImport("CGALWrapper", EntryPoint = "Skeleton2_BatchOffsets2f", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int CGAL_BatchOffsets(Vector2f[] inPoints, int[] inRingSizes, int[] inPolygonRings, int numPolygons, double[] inOffsets, int numOffsets, bool exterior, out PolygonBufferDescriptor descriptor);
+
+        [DllImport("CGALWrapper", EntryPoint = "Skeleton2_GetBatchOffsets2f", CallingConvention = CallingConvention.Cdecl)]
+        private static extern void CGAL_GetBatchOffsets([Out] Vector2f[] outPoints, [Out] int[] outRingSizes, [Out] int[] outPolygonRings, [Out] int[] outOffsetIndices, [Out] int[] outPolygonOffsets);
+
     }
 }
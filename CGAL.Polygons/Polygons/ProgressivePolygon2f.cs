@@ -0,0 +1,146 @@
+﻿using System;
+using System.Collections.Generic;
+
+using Common.Core.LinearAlgebra;
+
+namespace CGAL.Polygons
+{
+    //A polygon simplified once to completion. Level k is the polygon without the
+    //first k vertices of the removal order, so any level can be taken without
+    //simplifying again.
+    public class ProgressivePolygon2f
+    {
+
+        public Vector2f[] Positions { get; private set; }
+
+        public int[] RemovalOrder { get; private set; }
+
+        public float[] RemovalCosts { get; private set; }
+
+        public int MinCount { get { return Positions.Length - RemovalOrder.Length; } }
+
+        //Highest cost offered so far and the removals made before each offer.
+        //Blocked vertices are offered too, so these rather than the removal
+        //costs decide where a cost threshold stops.
+        private float[] m_offeredCosts;
+
+        private int[] m_offeredRemovals;
+
+        //The vertices of the last level taken linked in index order. Moving to
+        //another level unlinks or relinks only the vertices between the two,
+        //so taking levels is not safe from more than one thread.
+        private int[] m_next, m_prev;
+
+        private int m_head;
+
+        private int m_level;
+
+        public ProgressivePolygon2f(Vector2f[] positions, int[] removalOrder, float[] removalCosts, float[] offeredCosts, int[] offeredRemovals)
+        {
+            Positions = positions;
+            RemovalOrder = removalOrder;
+            RemovalCosts = removalCosts;
+
+            m_offeredCosts = offeredCosts;
+            m_offeredRemovals = offeredRemovals;
+
+            int n = positions.Length;
+            m_next = new int[n];
+            m_prev = new int[n];
+
+            for (int i = 0; i < n; i++)
+            {
+                m_next[i] = (i + 1) % n;
+                m_prev[i] = (i + n - 1) % n;
+            }
+
+            m_head = 0;
+            m_level = 0;
+        }
+
+        //Same stop rule as the count ratio simplification.
+        public Polygon2f GetLevel(float ratio)
+        {
+            ratio = Math.Max(0.0f, Math.Min(1.0f, ratio));
+            int keep = (int)Math.Floor(Positions.Length * ratio);
+            return GetLevelWithCount(keep);
+        }
+
+        //Stops at the first vertex offered at more than the threshold.
+        public Polygon2f GetLevelAtCost(float threshold)
+        {
+            int lo = 0, hi = m_offeredCosts.Length;
+            while (lo < hi)
+            {
+                int mid = (lo + hi) / 2;
+                if (m_offeredCosts[mid] <= threshold)
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+
+            if (lo == m_offeredCosts.Length)
+                return GetLevelWithRemovals(RemovalOrder.Length);
+
+            return GetLevelWithRemovals(m_offeredRemovals[lo]);
+        }
+
+        public Polygon2f GetLevelWithCount(int count)
+        {
+            return GetLevelWithRemovals(Positions.Length - count);
+        }
+
+        public List<Polygon2f> GetLevels(IList<float> ratios)
+        {
+            List<Polygon2f> levels = new List<Polygon2f>(ratios.Count);
+
+            for (int i = 0; i < ratios.Count; i++)
+                levels.Add(GetLevel(ratios[i]));
+
+            return levels;
+        }
+
+        //Costs the vertices between the current level and this one plus the
+        //vertices in the level.
+        private Polygon2f GetLevelWithRemovals(int removals)
+        {
+            removals = Math.Max(0, Math.Min(RemovalOrder.Length, removals));
+
+            while (m_level < removals)
+                Unlink(RemovalOrder[m_level++]);
+
+            while (m_level > removals)
+                Relink(RemovalOrder[--m_level]);
+
+            int size = Positions.Length - removals;
+
+            Polygon2f polygon = new Polygon2f(size);
+            for (int i = 0, v = m_head; i < size; i++, v = m_next[v])
+                polygon.Positions[i] = Positions[v];
+
+            polygon.CalculatePolygon();
+            return polygon;
+        }
+
+        private void Unlink(int v)
+        {
+            m_next[m_prev[v]] = m_next[v];
+            m_prev[m_next[v]] = m_prev[v];
+
+            if (v == m_head)
+                m_head = m_next[v];
+        }
+
+        //Relinking in the reverse of the unlink order finds the neighbours
+        //still pointing at the vertex, as they were when it was unlinked.
+        private void Relink(int v)
+        {
+            m_next[m_prev[v]] = v;
+            m_prev[m_next[v]] = v;
+
+            if (v < m_head)
+                m_head = v;
+        }
+
+    }
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+﻿using System;
+using System.Collections.Generic;
+
+using Common.Core.LinearAlgebra;
+using CGAL.Meshes.Descriptors;
+
+namespace CGAL.Polygons
+{
+    //A straight skeleton as flat arrays. Edges hold one entry per pair of
+    //halfedges and the connections refer to halfedges.
+    public class Skeleton2f
+    {
+
+        public Vector2f[] Points { get; private set; }
+
+        public EdgeIndex[] Edges { get; private set; }
+
+        public EdgeConnection[] Connections { get; private set; }
+
+        //Time each vertex was reached by the wavefront. Zero on the contour.
+        public float[] Times { get; private set; }
+
+        public bool[] IsContour { get; private set; }
+
+        public Skeleton2f(Vector2f[] points, EdgeIndex[] edges, EdgeConnection[] connections, float[] times, bool[] isContour)
+        {
+            Points = points;
+            Edges = edges;
+            Connections = connections;
+            Times = times;
+            IsContour = isContour;
+        }
+
+    }
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+namespace Descriptors
+{
+
+	typedef struct PartitionReport {
+		int method;
+		int parts;
+		int lowerBound;
+	} PartitionReport;
+
+}
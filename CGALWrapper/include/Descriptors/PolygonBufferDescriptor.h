@@ -0,0 +1,12 @@
+#pragma once
+
+namespace Descriptors
+{
+
+	typedef struct PolygonBufferDescriptor {
+		int polygons;
+		int rings;
+		int points;
+	} PolygonBufferDescriptor;
+
+}
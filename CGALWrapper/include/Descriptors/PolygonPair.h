@@ -0,0 +1,12 @@
+#pragma once
+
+namespace Descriptors
+{
+
+	typedef struct PolygonPair {
+		int a;
+		int b;
+		double area;
+	} PolygonPair;
+
+}
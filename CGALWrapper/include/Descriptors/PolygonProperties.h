@@ -0,0 +1,21 @@
+#pragma once
+
+namespace Descriptors
+{
+
+	//Simple is -1 when the check was not asked for.
+	typedef struct PolygonProperties {
+		double area;
+		double perimeter;
+		double centroidX;
+		double centroidY;
+		float xmin;
+		float ymin;
+		float xmax;
+		float ymax;
+		int simple;
+		int convex;
+		int orientation;
+	} PolygonProperties;
+
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+namespace Descriptors
+{
+
+	typedef struct RayHit {
+		float distance;
+		int polygon;
+		int edge;
+	} RayHit;
+
+}
@@ -2,8 +2,10 @@
 
 #include "stdafx.h"
 #include "Primatives/Point2.h"
+#include "Descriptors/PolygonBufferDescriptor.h"
 
 using namespace Primatives;
+using namespace Descriptors;
 
 namespace MinkowskiSums2
 {
@@ -21,6 +23,10 @@ namespace MinkowskiSums2
 
 		CGALWRAPPERAPI CGALResult CALLCON MinkowskiSums2_ComputeSum();
 
+		CGALWRAPPERAPI CGALResult CALLCON MinkowskiSums2_ComputeSumWith(int requested);
+
+		CGALWRAPPERAPI int CALLCON MinkowskiSums2_GetStrategy();
+
 		CGALWRAPPERAPI int CALLCON MinkowskiSums2_NumPolygonPoints();
 
 		CGALWRAPPERAPI int CALLCON MinkowskiSums2_NumPolygonHoles();
@@ -31,6 +37,14 @@ namespace MinkowskiSums2
 
 		CGALWRAPPERAPI Point2f CALLCON MinkowskiSums2_GetHolePoint2f(int holeIndex, int pointIndex);
 
+		CGALWRAPPERAPI CGALResult CALLCON MinkowskiSums2_BatchSum2f(const Point2f* inB, int bSize, BOOL reflectB, const Point2f* inPoints, const int* inRingSizes, const int* inPolygonRings, int numPolygons, BOOL unionSums, PolygonBufferDescriptor& descriptor);
+
+		CGALWRAPPERAPI void CALLCON MinkowskiSums2_GetBatchSum2f(Point2f* outPoints, int* outRingSizes, int* outPolygonRings, int* outPolygonOffsets);
+
+		CGALWRAPPERAPI CGALResult CALLCON MinkowskiSums2_Offset2f(const Point2f* inPoints, const int* inRingSizes, const int* inPolygonRings, int numPolygons, double radius, double tolerance, PolygonBufferDescriptor& descriptor);
+
+		CGALWRAPPERAPI void CALLCON MinkowskiSums2_GetOffset2f(Point2f* outPoints, int* outRingSizes, int* outPolygonRings, int* outPolygonOffsets);
+
 	}
 
 }
\ No newline at end of file
@@ -2,8 +2,11 @@
 
 #include "stdafx.h"
 #include "Primatives/Point2.h"
+#include "Descriptors/PolygonProperties.h"
+#include "Descriptors/PolygonBufferDescriptor.h"
 
 using namespace Primatives;
+using namespace Descriptors;
 
 namespace Polygon2
 {
@@ -22,6 +25,12 @@ namespace Polygon2
 		CGALWRAPPERAPI int CALLCON Polygon2_Orientation();
 
 		CGALWRAPPERAPI float CALLCON Polygon2_SignedArea();
+
+		CGALWRAPPERAPI CGALResult CALLCON Polygon2_BatchProperties2f(const Point2f* inPoints, const int* inRingSizes, const int* inPolygonRings, int numPolygons, BOOL checkSimple, PolygonProperties* outProperties);
+
+		CGALWRAPPERAPI CGALResult CALLCON Polygon2_BuildHierarchy2f(const Point2f* inPoints, const int* inRingSizes, int numRings, PolygonBufferDescriptor& descriptor);
+
+		CGALWRAPPERAPI void CALLCON Polygon2_GetHierarchy2f(Point2f* outPoints, int* outRingSizes, int* outPolygonRings, int* outDepths, int* outParents);
 	}
 
 }
@@ -2,8 +2,11 @@
 
 #include "stdafx.h"
 #include "Primatives/Point2.h"
+#include "Descriptors/PolygonPair.h"
+#include "Descriptors/PolygonBufferDescriptor.h"
 
 using namespace Primatives;
+using namespace Descriptors;
 
 namespace PolygonBoolean2
 {
@@ -45,6 +48,18 @@ namespace PolygonBoolean2
 
 		CGALWRAPPERAPI Point2f CALLCON Boolean2_GetHolePoint2f(int holeIndex, int pointIndex);
 
+		CGALWRAPPERAPI void CALLCON Boolean2_Batch_A_LoadPolygons2f(const Point2f* inPoints, const int* inRingSizes, const int* inPolygonRings, int numPolygons);
+
+		CGALWRAPPERAPI void CALLCON Boolean2_Batch_B_LoadPolygons2f(const Point2f* inPoints, const int* inRingSizes, const int* inPolygonRings, int numPolygons);
+
+		CGALWRAPPERAPI int CALLCON Boolean2_BatchDoIntersect(BOOL computeArea);
+
+		CGALWRAPPERAPI void CALLCON Boolean2_GetBatchPairs(PolygonPair* outPairs, int size);
+
+		CGALWRAPPERAPI CGALResult CALLCON Boolean2_ClipToGrid2f(const Point2f* inPoints, const int* inRingSizes, const int* inPolygonRings, int numPolygons, Point2f origin, float tileWidth, float tileHeight, int columns, int rows, PolygonBufferDescriptor& descriptor);
+
+		CGALWRAPPERAPI void CALLCON Boolean2_GetGridTiles2f(Point2f* outPoints, int* outRingSizes, int* outPolygonRings, int* outTileOffsets, int* outSources);
+
 	}
 
 }
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "stdafx.h"
+#include "Primatives/Point2.h"
+
+using namespace Primatives;
+
+namespace PolygonDistance2
+{
+
+	extern "C"
+	{
+
+		CGALWRAPPERAPI CGALResult CALLCON Distance2_SignedDistanceField2f(const Point2f* inPoints, const int* inRingSizes, const int* inPolygonRings, int numPolygons,
+			float xmin, float ymin, float cellSize, int width, int height, float* outField);
+
+	}
+
+}
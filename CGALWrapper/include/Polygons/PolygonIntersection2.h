@@ -2,8 +2,10 @@
 
 #include "stdafx.h"
 #include "Primatives/Point2.h"
+#include "Descriptors/RayHit.h"
 
 using namespace Primatives;
+using namespace Descriptors;
 
 namespace PolygonIntersection2
 {
@@ -19,8 +21,18 @@ namespace PolygonIntersection2
 
 		CGALWRAPPERAPI void CALLCON Intersection2_PopAll();
 
+		CGALWRAPPERAPI void CALLCON Intersection2_SetEdgeGridThreshold(int numEdges);
+
 		CGALWRAPPERAPI BOOL CALLCON Intersection2_ContainsPoint2f(Point2f point);
 
+		CGALWRAPPERAPI CGALResult CALLCON Intersection2_BatchContainsPoints2f(const Point2f* inPoints, int numPoints, int* outIndices);
+
+		CGALWRAPPERAPI CGALResult CALLCON Intersection2_BatchContainsPointsMask2f(const Point2f* inPoints, int numPoints, unsigned char* outMask);
+
+		CGALWRAPPERAPI CGALResult CALLCON Intersection2_BatchRaycast2f(const Point2f* inOrigins, const Point2f* inDirections, int numRays, float maxDistance, RayHit* outHits);
+
+		CGALWRAPPERAPI CGALResult CALLCON Intersection2_BatchSegmentHits2f(const Point2f* inStarts, const Point2f* inEnds, int numSegments, RayHit* outHits);
+
 	}
 
 }
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "stdafx.h"
+#include "Primatives/Point2.h"
+#include "Descriptors/PolygonPair.h"
+#include "Descriptors/PolygonBufferDescriptor.h"
+
+using namespace Primatives;
+using namespace Descriptors;
+
+namespace PolygonOverlay2
+{
+
+	extern "C"
+	{
+
+		CGALWRAPPERAPI void CALLCON Overlay2_A_LoadPolygons2f(const Point2f* inPoints, const int* inRingSizes, const int* inPolygonRings, int numPolygons);
+
+		CGALWRAPPERAPI void CALLCON Overlay2_B_LoadPolygons2f(const Point2f* inPoints, const int* inRingSizes, const int* inPolygonRings, int numPolygons);
+
+		CGALWRAPPERAPI void CALLCON Overlay2_Clear();
+
+		CGALWRAPPERAPI void CALLCON Overlay2_Release();
+
+		CGALWRAPPERAPI CGALResult CALLCON Overlay2_Compute(BOOL intersectionOnly, PolygonBufferDescriptor& descriptor);
+
+		CGALWRAPPERAPI void CALLCON Overlay2_GetFaces2f(Point2f* outPoints, int* outRingSizes, int* outPolygonRings, PolygonPair* outSources);
+
+	}
+
+}
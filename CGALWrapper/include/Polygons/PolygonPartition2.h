@@ -2,8 +2,10 @@
 
 #include "stdafx.h"
 #include "Primatives/Point2.h"
+#include "Descriptors/PartitionReport.h"
 
 using namespace Primatives;
+using namespace Descriptors;
 
 namespace PolygonPartition2
 {
@@ -25,10 +27,26 @@ namespace PolygonPartition2
 
 		CGALWRAPPERAPI int CALLCON Partition2_OptimalConvexPartition();
 
+		CGALWRAPPERAPI int CALLCON Partition2_AutoPartition();
+
+		CGALWRAPPERAPI void CALLCON Partition2_SetAutoPartition(double budget, int fallbackMethod);
+
+		CGALWRAPPERAPI PartitionReport CALLCON Partition2_GetReport();
+
 		CGALWRAPPERAPI int CALLCON Partition2_GetPolygonSize(int i);
 
 		CGALWRAPPERAPI Point2f CALLCON Partition2_GetPolygonPoint2f(int i, int j);
 
+		CGALWRAPPERAPI int CALLCON Partition2_BatchPartition2f(const Point2f* inPoints, const int* inSizes, int numPolygons, int method);
+
+		CGALWRAPPERAPI int CALLCON Partition2_TriangulationPartition2f(const Point2f* inPoints, const int* inRingSizes, const int* inPolygonRings, int numPolygons);
+
+		CGALWRAPPERAPI int CALLCON Partition2_BatchNumPoints();
+
+		CGALWRAPPERAPI void CALLCON Partition2_GetBatchPartition2f(Point2f* outPoints, int* outPolygonOffsets, int* outPartOffsets);
+
+		CGALWRAPPERAPI void CALLCON Partition2_GetBatchReports(PartitionReport* outReports);
+
 	}
 
 }
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "stdafx.h"
+#include "Primatives/Point2.h"
+
+using namespace Primatives;
+
+namespace PolygonSet2
+{
+
+	extern "C"
+	{
+
+		CGALWRAPPERAPI void CALLCON PolygonSet2_LoadBrush2f(const Point2f* inPoints, int inSize);
+
+		CGALWRAPPERAPI void CALLCON PolygonSet2_AddBrushHole2f(const Point2f* inPoints, int inSize);
+
+		CGALWRAPPERAPI void CALLCON PolygonSet2_Clear();
+
+		CGALWRAPPERAPI void CALLCON PolygonSet2_Release();
+
+		CGALWRAPPERAPI CGALResult CALLCON PolygonSet2_Insert();
+
+		CGALWRAPPERAPI CGALResult CALLCON PolygonSet2_Join();
+
+		CGALWRAPPERAPI CGALResult CALLCON PolygonSet2_Difference();
+
+		CGALWRAPPERAPI CGALResult CALLCON PolygonSet2_Intersect();
+
+		CGALWRAPPERAPI int CALLCON PolygonSet2_NumPolygons();
+
+		CGALWRAPPERAPI void CALLCON PolygonSet2_GetPolygonIds(int* outIds);
+
+		CGALWRAPPERAPI int CALLCON PolygonSet2_NumAdded();
+
+		CGALWRAPPERAPI void CALLCON PolygonSet2_GetAddedIds(int* outIds);
+
+		CGALWRAPPERAPI int CALLCON PolygonSet2_NumRemoved();
+
+		CGALWRAPPERAPI void CALLCON PolygonSet2_GetRemovedIds(int* outIds);
+
+		CGALWRAPPERAPI void CALLCON PolygonSet2_ClearChanges();
+
+		CGALWRAPPERAPI BOOL CALLCON PolygonSet2_PointToPolygon(int id);
+
+		CGALWRAPPERAPI int CALLCON PolygonSet2_NumPolygonPoints();
+
+		CGALWRAPPERAPI int CALLCON PolygonSet2_NumPolygonHoles();
+
+		CGALWRAPPERAPI int CALLCON PolygonSet2_NumHolePoints(int holeIndex);
+
+		CGALWRAPPERAPI Point2f CALLCON PolygonSet2_GetPolygonPoint2f(int pointIndex);
+
+		CGALWRAPPERAPI Point2f CALLCON PolygonSet2_GetHolePoint2f(int holeIndex, int pointIndex);
+
+	}
+
+}
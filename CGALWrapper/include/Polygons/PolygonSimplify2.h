@@ -2,8 +2,10 @@
 
 #include "stdafx.h"
 #include "Primatives/Point2.h"
+#include "Descriptors/PolygonBufferDescriptor.h"
 
 using namespace Primatives;
+using namespace Descriptors;
 
 namespace PolygonSimplify2
 {
@@ -21,8 +23,38 @@ namespace PolygonSimplify2
 
 		CGALWRAPPERAPI int CALLCON Simplify2_ScaledSquareDistCostSimplify(float threshold);
 
+		CGALWRAPPERAPI int CALLCON Simplify2_CostThresholdSimplify(float threshold, int method);
+
+		CGALWRAPPERAPI int CALLCON Simplify2_CountThresholdSimplify(int count, int method);
+
 		CGALWRAPPERAPI Point2f CALLCON Simplify2_GetSimplifiedPoint2f(int i);
 
+		CGALWRAPPERAPI int CALLCON Simplify2_ProgressiveSimplify(int method);
+
+		CGALWRAPPERAPI void CALLCON Simplify2_GetRemovalOrder(int* outIndices, float* outCosts);
+
+		CGALWRAPPERAPI int CALLCON Simplify2_GetOfferCount();
+
+		CGALWRAPPERAPI void CALLCON Simplify2_GetOffers(float* outCosts, int* outRemovals);
+
+		CGALWRAPPERAPI CGALResult CALLCON Simplify2_BatchSimplify2f(const Point2f* inPoints, const int* inRingSizes, const int* inPolygonRings, int numPolygons, float threshold, int method);
+
+		CGALWRAPPERAPI PolygonBufferDescriptor CALLCON Simplify2_GetBatchDescriptor();
+
+		CGALWRAPPERAPI void CALLCON Simplify2_GetBatch2f(Point2f* outPoints, int* outRingSizes, int* outPolygonRings);
+
+		CGALWRAPPERAPI void CALLCON Simplify2_BeginStream(int method, float threshold, int windowSize);
+
+		CGALWRAPPERAPI int CALLCON Simplify2_PushStream2f(const Point2f* inPoints, int inSize);
+
+		CGALWRAPPERAPI int CALLCON Simplify2_EndStream();
+
+		CGALWRAPPERAPI void CALLCON Simplify2_GetStream2f(Point2f* outPoints);
+
+		CGALWRAPPERAPI CGALResult CALLCON Simplify2_MultiThresholdSimplify(const float* thresholds, int numThresholds, int criterion, int method, int* outCounts);
+
+		CGALWRAPPERAPI void CALLCON Simplify2_GetMultiThreshold2f(Point2f* outPoints);
+
 	}
 
 }
@@ -5,6 +5,7 @@
 #include "Descriptors/MeshDescriptor.h"
 #include "Descriptors/EdgeIndex.h"
 #include "Descriptors/EdgeConnection.h"
+#include "Descriptors/PolygonBufferDescriptor.h"
 
 using namespace Primatives;
 using namespace Descriptors;
@@ -27,6 +28,8 @@ namespace PolygonSkeleton2
 
 		CGALWRAPPERAPI CGALResult CALLCON Skeleton2_CreateExteriorSkeleton(double maxOffset, BOOL includeBorder, MeshDescriptor& descriptor);
 
+		CGALWRAPPERAPI CGALResult CALLCON Skeleton2_CreateApproximateMedialAxis(double tolerance, double pruneLength, MeshDescriptor& descriptor);
+
 		CGALWRAPPERAPI int CALLCON Skeleton2_CreateInteriorOffset(double offset);
 
 		CGALWRAPPERAPI Point2f CALLCON Skeleton2_GetSkeletonPoint2f(int i);
@@ -37,10 +40,24 @@ namespace PolygonSkeleton2
 
 		CGALWRAPPERAPI EdgeConnection CALLCON Skeleton2_GetEdgeConnection(int i);
 
+		CGALWRAPPERAPI void CALLCON Skeleton2_GetSkeleton2f(Point2f* outPoints, EdgeIndex* outEdges, EdgeConnection* outConnections, float* outTimes, unsigned char* outContour);
+
 		CGALWRAPPERAPI int CALLCON Skeleton2_NumPolygonPoints(int polygonIndex);
 
 		CGALWRAPPERAPI Point2f CALLCON Skeleton2_GetPolygonPoint2f(int polygonIndex, int pointIndex);
 
+		CGALWRAPPERAPI CGALResult CALLCON Skeleton2_CreateOffsets(const double* inOffsets, int numOffsets, BOOL exterior, PolygonBufferDescriptor& descriptor);
+
+		CGALWRAPPERAPI void CALLCON Skeleton2_GetOffsets2f(Point2f* outPoints, int* outRingSizes, int* outPolygonRings, int* outOffsetIndices);
+
+		CGALWRAPPERAPI CGALResult CALLCON Skeleton2_BatchSkeleton2f(const Point2f* inPoints, const int* inRingSizes, const int* inPolygonRings, int numPolygons, BOOL exterior, double maxOffset, BOOL includeBorder, MeshDescriptor& descriptor);
+
+		CGALWRAPPERAPI void CALLCON Skeleton2_GetBatchSkeletonOffsets(int* outVertexOffsets, int* outEdgeOffsets, int* outConnectionOffsets);
+
+		CGALWRAPPERAPI CGALResult CALLCON Skeleton2_BatchOffsets2f(const Point2f* inPoints, const int* inRingSizes, const int* inPolygonRings, int numPolygons, const double* inOffsets, int numOffsets, BOOL exterior, PolygonBufferDescriptor& descriptor);
+
+		CGALWRAPPERAPI void CALLCON Skeleton2_GetBatchOffsets2f(Point2f* outPoints, int* outRingSizes, int* outPolygonRings, int* outOffsetIndices, int* outPolygonOffsets);
+
 	}
 
 }
\ No newline at end of file
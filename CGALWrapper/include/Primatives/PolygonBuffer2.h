@@ -0,0 +1,204 @@
+#pragma once
+
+#include "stdafx.h"
+#include "Primatives/Point2.h"
+#include "Descriptors/PolygonBufferDescriptor.h"
+
+#include <CGAL/Bbox_2.h>
+#include <vector>
+#include <algorithm>
+
+namespace Primatives
+{
+
+	//Polygons with holes packed into flat arrays. Each polygon owns polygonRings[i]
+	//consecutive rings, the first being the outer boundary and the rest its holes.
+	//Each ring owns ringSizes[r] consecutive points.
+	struct PolygonBuffer2f
+	{
+		std::vector<Point2f> points;
+		std::vector<int> ringSizes;
+		std::vector<int> polygonRings;
+
+		std::vector<int> ringOffsets;
+		std::vector<int> pointOffsets;
+
+		void Clear()
+		{
+			points.clear();
+			ringSizes.clear();
+			polygonRings.clear();
+			ringOffsets.clear();
+			pointOffsets.clear();
+		}
+
+		void Release()
+		{
+			points.resize(0);
+			ringSizes.resize(0);
+			polygonRings.resize(0);
+			ringOffsets.resize(0);
+			pointOffsets.resize(0);
+		}
+
+		void Load(const Point2f* inPoints, const int* inRingSizes, const int* inPolygonRings, int numPolygons)
+		{
+			Clear();
+
+			if (inPoints == nullptr || inRingSizes == nullptr || inPolygonRings == nullptr) return;
+			if (numPolygons < 1) return;
+
+			int ring = 0, point = 0;
+			for (int i = 0; i < numPolygons; i++)
+			{
+				polygonRings.push_back(inPolygonRings[i]);
+				ringOffsets.push_back(ring);
+
+				for (int j = 0; j < inPolygonRings[i]; j++, ring++)
+				{
+					ringSizes.push_back(inRingSizes[ring]);
+					pointOffsets.push_back(point);
+					point += inRingSizes[ring];
+				}
+			}
+
+			points.assign(inPoints, inPoints + point);
+		}
+
+		int NumPolygons() const
+		{
+			return int(polygonRings.size());
+		}
+
+		int NumHoles(int polygon) const
+		{
+			return polygonRings[polygon] - 1;
+		}
+
+		const Point2f* RingPoints(int ring) const
+		{
+			return points.data() + pointOffsets[ring];
+		}
+
+		CGAL::Bbox_2 Bbox(int polygon) const
+		{
+			int ring = ringOffsets[polygon];
+			const Point2f* p = RingPoints(ring);
+
+			if (ringSizes[ring] == 0) return CGAL::Bbox_2();
+
+			double xmin = p[0].x, ymin = p[0].y;
+			double xmax = p[0].x, ymax = p[0].y;
+
+			for (int i = 1; i < ringSizes[ring]; i++)
+			{
+				xmin = std::min<double>(xmin, p[i].x);
+				ymin = std::min<double>(ymin, p[i].y);
+				xmax = std::max<double>(xmax, p[i].x);
+				ymax = std::max<double>(ymax, p[i].y);
+			}
+
+			return CGAL::Bbox_2(xmin, ymin, xmax, ymax);
+		}
+
+		template <class POLYGON>
+		POLYGON ToRing(int ring) const
+		{
+			typedef typename POLYGON::Point_2 Point;
+
+			std::vector<Point> ringPoints = ToPointArray2<Point, Point2f>(RingPoints(ring), ringSizes[ring]);
+			return POLYGON(ringPoints.begin(), ringPoints.end());
+		}
+
+		template <class POLYGON_WITH_HOLES>
+		POLYGON_WITH_HOLES ToPolygon(int polygon) const
+		{
+			typedef typename POLYGON_WITH_HOLES::General_polygon_2 Polygon;
+
+			int ring = ringOffsets[polygon];
+			POLYGON_WITH_HOLES pwh(ToRing<Polygon>(ring));
+
+			for (int i = 1; i < polygonRings[polygon]; i++)
+				pwh.add_hole(ToRing<Polygon>(ring + i));
+
+			return pwh;
+		}
+
+		template <class POLYGON>
+		void AddRing(const POLYGON& polygon)
+		{
+			pointOffsets.push_back(int(points.size()));
+			ringSizes.push_back(int(polygon.size()));
+
+			for (auto p = polygon.vertices_begin(); p != polygon.vertices_end(); ++p)
+			{
+				float x = float(CGAL::to_double(p->x()));
+				float y = float(CGAL::to_double(p->y()));
+				points.push_back({ x, y });
+			}
+		}
+
+		template <class POLYGON>
+		void AddPolygon(const POLYGON& polygon)
+		{
+			ringOffsets.push_back(int(ringSizes.size()));
+			polygonRings.push_back(1);
+			AddRing(polygon);
+		}
+
+		template <class POLYGON_WITH_HOLES>
+		void AddPolygonWithHoles(const POLYGON_WITH_HOLES& polygon)
+		{
+			ringOffsets.push_back(int(ringSizes.size()));
+			polygonRings.push_back(1 + int(polygon.number_of_holes()));
+
+			AddRing(polygon.outer_boundary());
+			for (auto hole = polygon.holes_begin(); hole != polygon.holes_end(); ++hole)
+				AddRing(*hole);
+		}
+
+		void Append(const PolygonBuffer2f& buffer)
+		{
+			int ringStart = int(ringSizes.size());
+			int pointStart = int(points.size());
+
+			for (size_t i = 0; i < buffer.polygonRings.size(); i++)
+			{
+				polygonRings.push_back(buffer.polygonRings[i]);
+				ringOffsets.push_back(ringStart + buffer.ringOffsets[i]);
+			}
+
+			for (size_t i = 0; i < buffer.ringSizes.size(); i++)
+			{
+				ringSizes.push_back(buffer.ringSizes[i]);
+				pointOffsets.push_back(pointStart + buffer.pointOffsets[i]);
+			}
+
+			points.insert(points.end(), buffer.points.begin(), buffer.points.end());
+		}
+
+		Descriptors::PolygonBufferDescriptor Descriptor() const
+		{
+			Descriptors::PolygonBufferDescriptor descriptor;
+			descriptor.polygons = int(polygonRings.size());
+			descriptor.rings = int(ringSizes.size());
+			descriptor.points = int(points.size());
+
+			return descriptor;
+		}
+
+		void CopyTo(Point2f* outPoints, int* outRingSizes, int* outPolygonRings) const
+		{
+			if (outPoints != nullptr)
+				std::copy(points.begin(), points.end(), outPoints);
+
+			if (outRingSizes != nullptr)
+				std::copy(ringSizes.begin(), ringSizes.end(), outRingSizes);
+
+			if (outPolygonRings != nullptr)
+				std::copy(polygonRings.begin(), polygonRings.end(), outPolygonRings);
+		}
+
+	};
+
+}
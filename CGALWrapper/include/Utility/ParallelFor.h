@@ -0,0 +1,65 @@
+#pragma once
+
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <exception>
+#include <algorithm>
+
+namespace Utility
+{
+
+	//Runs func(i) for i in [0, count) across the hardware threads.
+	//Items are handed out one at a time so uneven work balances itself.
+	//The first exception thrown by func is rethrown on the calling thread.
+	template <class FUNC>
+	void ParallelFor(int count, FUNC func, int maxThreads = 0)
+	{
+		if (count <= 0) return;
+
+		int numThreads = int(std::thread::hardware_concurrency());
+		if (maxThreads > 0) numThreads = (std::min)(numThreads, maxThreads);
+		numThreads = (std::max)(1, (std::min)(numThreads, count));
+
+		if (numThreads == 1)
+		{
+			for (int i = 0; i < count; i++)
+				func(i);
+
+			return;
+		}
+
+		std::atomic<int> next(0);
+		std::atomic<bool> failed(false);
+		std::exception_ptr error;
+		std::mutex errorLock;
+
+		auto worker = [&]()
+		{
+			try
+			{
+				for (int i = next++; i < count && !failed; i = next++)
+					func(i);
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock(errorLock);
+				if (!failed) error = std::current_exception();
+				failed = true;
+			}
+		};
+
+		std::vector<std::thread> threads;
+		for (int i = 1; i < numThreads; i++)
+			threads.push_back(std::thread(worker));
+
+		worker();
+
+		for (auto& thread : threads)
+			thread.join();
+
+		if (error) std::rethrow_exception(error);
+	}
+
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <CGAL/Constrained_Delaunay_triangulation_2.h>
+#include <CGAL/Triangulation_face_base_with_info_2.h>
+
+#include <list>
+#include <vector>
+
+namespace Utility
+{
+
+	struct FaceInfo2
+	{
+		FaceInfo2() {}
+		int nestingLevel;
+		int id;
+
+		bool InDomain()
+		{
+			return nestingLevel % 2 == 1;
+		}
+	};
+
+	//Constrained triangulation whose faces can be marked inside or outside
+	//the polygon the constraints outline.
+	template <class K>
+	struct DomainTriangulation
+	{
+		typedef CGAL::Triangulation_vertex_base_2<K> Vb;
+		typedef CGAL::Triangulation_face_base_with_info_2<FaceInfo2, K> Fbb;
+		typedef CGAL::Constrained_triangulation_face_base_2<K, Fbb> Fb;
+		typedef CGAL::Triangulation_data_structure_2<Vb, Fb> TDS;
+		typedef CGAL::Exact_predicates_tag Itag;
+		typedef CGAL::Constrained_Delaunay_triangulation_2<K, TDS, Itag> CDT;
+	};
+
+	//Flood fills the faces between constraints. Faces with an odd nesting
+	//level are inside the polygon and even levels are outside or in a hole.
+	template <class CDT>
+	void MarkDomains(CDT& cdt, typename CDT::Face_handle start, int index, std::list<typename CDT::Edge>& border)
+	{
+		if (start->info().nestingLevel != -1) return;
+
+		std::list<typename CDT::Face_handle> queue;
+		queue.push_back(start);
+
+		while (!queue.empty())
+		{
+			typename CDT::Face_handle face = queue.front();
+			queue.pop_front();
+
+			if (face->info().nestingLevel != -1) continue;
+			face->info().nestingLevel = index;
+
+			for (int i = 0; i < 3; i++)
+			{
+				typename CDT::Edge e(face, i);
+				typename CDT::Face_handle n = face->neighbor(i);
+
+				if (n->info().nestingLevel == -1)
+				{
+					if (cdt.is_constrained(e))
+						border.push_back(e);
+					else
+						queue.push_back(n);
+				}
+			}
+		}
+	}
+
+	template <class CDT>
+	void MarkDomains(CDT& cdt)
+	{
+		for (auto face = cdt.all_faces_begin(); face != cdt.all_faces_end(); ++face)
+		{
+			face->info().nestingLevel = -1;
+			face->info().id = -1;
+		}
+
+		std::list<typename CDT::Edge> border;
+		MarkDomains(cdt, cdt.infinite_face(), 0, border);
+
+		while (!border.empty())
+		{
+			typename CDT::Edge e = border.front();
+			border.pop_front();
+
+			typename CDT::Face_handle n = e.first->neighbor(e.second);
+			if (n->info().nestingLevel == -1)
+				MarkDomains(cdt, n, e.first->info().nestingLevel + 1, border);
+		}
+	}
+
+	//Root of the set holding i, halving the path on the way up.
+	inline int FindRoot(std::vector<int>& parent, int i)
+	{
+		while (parent[i] != i)
+		{
+			parent[i] = parent[parent[i]];
+			i = parent[i];
+		}
+
+		return i;
+	}
+
+}
@@ -1,12 +1,21 @@
 
 #include "stdafx.h"
 #include "Polygons/MinkowskiSums2.h"
+#include "Primatives/PolygonBuffer2.h"
+#include "Utility/ParallelFor.h"
+
 #include <CGAL/Exact_predicates_exact_constructions_kernel.h>
 #include <CGAL/minkowski_sum_2.h>
 
 #include <CGAL/Small_side_angle_bisector_decomposition_2.h>
 #include <CGAL/Polygon_triangulation_decomposition_2.h>
 #include <CGAL/Polygon_nop_decomposition_2.h>
+#include <CGAL/Polygon_convex_decomposition_2.h>
+#include <CGAL/Boolean_set_operations_2.h>
+#include <CGAL/Gps_circle_segment_traits_2.h>
+#include <CGAL/approximated_offset_2.h>
+
+#include <cmath>
 
 using namespace std;
 
@@ -18,9 +27,333 @@ namespace MinkowskiSums2
 	typedef CGAL::Polygon_2<Kernel> Polygon;
 	typedef CGAL::Polygon_with_holes_2<Kernel> PolygonWithHoles;
 
+	typedef CGAL::Gps_circle_segment_traits_2<Kernel> CircleTraits;
+	typedef CircleTraits::Polygon_2 OffsetPolygon;
+	typedef CircleTraits::Polygon_with_holes_2 OffsetPolygonWithHoles;
+	typedef CGAL::General_polygon_set_2<CircleTraits> OffsetPolygonSet;
+
+	const double PI = 3.14159265358979323846;
+
+	enum Strategy { AUTO, CONVEX, REDUCED_CONVOLUTION, SSAB, TRIANGULATION, OPTIMAL };
+
+	//Auto strategy limits. Decomposition sums every pair of convex pieces and
+	//unions the results, so it only pays while the pieces are few, roughly
+	//(rA + 1) * (rB + 1) for rA and rB reflex vertices. The optimal
+	//decomposition is O(n^4) so is kept to small polygons, and the small side
+	//angle bisector one is quadratic so large polygons are triangulated instead.
+	const int MAX_DECOMPOSITION_PIECES = 8;
+	const int MAX_OPTIMAL_VERTICES = 32;
+	const int MAX_SSAB_VERTICES = 512;
+
 	Polygon A, B;
 	PolygonWithHoles sum;
 	vector<PolygonWithHoles> holes;
+	int strategy = AUTO;
+
+	PolygonBuffer2f batchOutput;
+	vector<int> batchOffsets;
+
+	int CountReflex(const Polygon& polygon)
+	{
+		int n = int(polygon.size()), count = 0;
+
+		for (int i = 0; i < n; i++)
+		{
+			const Point& p0 = polygon[(i + n - 1) % n];
+			const Point& p1 = polygon[i];
+			const Point& p2 = polygon[(i + 1) % n];
+
+			if (CGAL::orientation(p0, p1, p2) == CGAL::RIGHT_TURN)
+				count++;
+		}
+
+		return count;
+	}
+
+	int ChooseStrategy(const Polygon& a, const Polygon& b)
+	{
+		int ra = CountReflex(a);
+		int rb = CountReflex(b);
+
+		if (ra == 0 && rb == 0) return CONVEX;
+
+		int pieces = (ra + 1) * (rb + 1);
+		if (pieces > MAX_DECOMPOSITION_PIECES) return REDUCED_CONVOLUTION;
+
+		int n = (std::max)(int(a.size()), int(b.size()));
+
+		if (n <= MAX_OPTIMAL_VERTICES) return OPTIMAL;
+		if (n <= MAX_SSAB_VERTICES) return SSAB;
+
+		return TRIANGULATION;
+	}
+
+	//Index of the lowest vertex, leftmost among equals.
+	int LowestVertex(const Polygon& polygon)
+	{
+		int lowest = 0;
+
+		for (int i = 1; i < int(polygon.size()); i++)
+		{
+			if (CGAL::compare_yx(polygon[i], polygon[lowest]) == CGAL::SMALLER)
+				lowest = i;
+		}
+
+		return lowest;
+	}
+
+	//Sum of two convex counter clockwise polygons by merging their edges in
+	//order of angle, starting from the lowest vertex of each. O(m + n).
+	PolygonWithHoles ConvexSum(const Polygon& a, const Polygon& b)
+	{
+		typedef Kernel::Vector_2 Vector;
+		typedef Kernel::Direction_2 Direction;
+
+		int n = int(a.size()), m = int(b.size());
+		int a0 = LowestVertex(a), b0 = LowestVertex(b);
+
+		auto edgeA = [&](int i) { return a[(a0 + i + 1) % n] - a[(a0 + i) % n]; };
+		auto edgeB = [&](int j) { return b[(b0 + j + 1) % m] - b[(b0 + j) % m]; };
+
+		Point p = a[a0] + (b[b0] - CGAL::ORIGIN);
+		vector<Point> points;
+		points.reserve(n + m);
+		points.push_back(p);
+
+		int i = 0, j = 0;
+		while (i < n || j < m)
+		{
+			Vector e;
+
+			if (j == m)
+				e = edgeA(i++);
+			else if (i == n)
+				e = edgeB(j++);
+			else
+			{
+				Vector ea = edgeA(i), eb = edgeB(j);
+				Direction da(ea), db(eb);
+
+				if (da < db)
+				{
+					e = ea;
+					i++;
+				}
+				else if (db < da)
+				{
+					e = eb;
+					j++;
+				}
+				else
+				{
+					e = ea + eb;
+					i++;
+					j++;
+				}
+			}
+
+			p = p + e;
+			if (i < n || j < m) points.push_back(p);
+		}
+
+		return PolygonWithHoles(Polygon(points.begin(), points.end()));
+	}
+
+	PolygonWithHoles ComputeSum(const Polygon& a, const Polygon& b, int requested, int& used)
+	{
+		used = requested;
+		if (used == AUTO || (used == CONVEX && !(a.is_convex() && b.is_convex())))
+			used = ChooseStrategy(a, b);
+
+		switch (used)
+		{
+		case CONVEX:
+			return ConvexSum(a, b);
+
+		case SSAB:
+		{
+			CGAL::Small_side_angle_bisector_decomposition_2<Kernel> decomposition;
+			return CGAL::minkowski_sum_2(a, b, decomposition);
+		}
+
+		case TRIANGULATION:
+		{
+			CGAL::Polygon_triangulation_decomposition_2<Kernel> decomposition;
+			return CGAL::minkowski_sum_2(a, b, decomposition);
+		}
+
+		case OPTIMAL:
+		{
+			CGAL::Optimal_convex_decomposition_2<Kernel> decomposition;
+			return CGAL::minkowski_sum_2(a, b, decomposition);
+		}
+
+		default:
+			used = REDUCED_CONVOLUTION;
+			return CGAL::minkowski_sum_2(a, b);
+		}
+	}
+
+	//Splits B into convex pieces with diagonals only, so every piece vertex is
+	//a vertex of B and the pieces round trip through floats exactly. Exact
+	//kernel objects are not shared between threads so each task rebuilds them.
+	//A B with many reflex vertices is left whole for the reduced convolution.
+	vector<vector<Point2f>> DecomposeOnce(const Polygon& b)
+	{
+		vector<Polygon> pieces;
+
+		int reflex = CountReflex(b);
+		if (reflex == 0 || reflex + 1 > MAX_DECOMPOSITION_PIECES)
+			pieces.push_back(b);
+		else if (int(b.size()) <= MAX_OPTIMAL_VERTICES)
+			CGAL::Optimal_convex_decomposition_2<Kernel>()(b, back_inserter(pieces));
+		else
+			CGAL::Greene_convex_decomposition_2<Kernel>()(b, back_inserter(pieces));
+
+		vector<vector<Point2f>> result(pieces.size());
+
+		for (size_t i = 0; i < pieces.size(); i++)
+		{
+			for (auto p = pieces[i].vertices_begin(); p != pieces[i].vertices_end(); ++p)
+			{
+				float x = float(CGAL::to_double(p->x()));
+				float y = float(CGAL::to_double(p->y()));
+				result[i].push_back({ x, y });
+			}
+		}
+
+		return result;
+	}
+
+	//Sums a convex obstacle with each piece of B and joins the results, as
+	//convex pieces against a convex obstacle are merged directly. Any other
+	//obstacle would need a reduced convolution per piece plus the join, more
+	//work than one reduced convolution with the whole of B, which also
+	//handles the obstacle's holes.
+	void SumPieces(const PolygonWithHoles& a, const vector<Point2f>& whole, const vector<vector<Point2f>>& pieces, vector<PolygonWithHoles>& out)
+	{
+		bool convex = a.number_of_holes() == 0 && a.outer_boundary().is_convex();
+
+		if (!convex)
+		{
+			vector<Point> points = ToPointArray2<Point, Point2f>(whole.data(), int(whole.size()));
+			out.push_back(CGAL::minkowski_sum_2(a, Polygon(points.begin(), points.end())));
+			return;
+		}
+
+		vector<PolygonWithHoles> sums;
+
+		for (auto& piece : pieces)
+		{
+			vector<Point> points = ToPointArray2<Point, Point2f>(piece.data(), int(piece.size()));
+			Polygon b(points.begin(), points.end());
+
+			if (b.is_convex())
+				sums.push_back(ConvexSum(a.outer_boundary(), b));
+			else
+				sums.push_back(CGAL::minkowski_sum_2(a, b));
+		}
+
+		if (sums.size() == 1)
+			out.push_back(sums[0]);
+		else
+			CGAL::join(sums.begin(), sums.end(), back_inserter(out));
+	}
+
+	//Appends the boundary with each circular arc split into chords that stay
+	//within the tolerance of the arc. The end of each curve is the start of
+	//the next so only the starts are written.
+	void AddOffsetRing(const OffsetPolygon& polygon, double tolerance, PolygonBuffer2f& out)
+	{
+		out.pointOffsets.push_back(int(out.points.size()));
+		size_t start = out.points.size();
+
+		for (auto curve = polygon.curves_begin(); curve != polygon.curves_end(); ++curve)
+		{
+			double sx = CGAL::to_double(curve->source().x());
+			double sy = CGAL::to_double(curve->source().y());
+			out.points.push_back({ float(sx), float(sy) });
+
+			if (!curve->is_circular()) continue;
+
+			double tx = CGAL::to_double(curve->target().x());
+			double ty = CGAL::to_double(curve->target().y());
+
+			const Kernel::Circle_2& circle = curve->supporting_circle();
+			double cx = CGAL::to_double(circle.center().x());
+			double cy = CGAL::to_double(circle.center().y());
+			double radius = std::sqrt(CGAL::to_double(circle.squared_radius()));
+
+			double a0 = std::atan2(sy - cy, sx - cx);
+			double a1 = std::atan2(ty - cy, tx - cx);
+
+			double sweep = (curve->orientation() == CGAL::COUNTERCLOCKWISE) ? a1 - a0 : a0 - a1;
+			if (sweep < 0) sweep += 2 * PI;
+
+			//An x-monotone arc spans at most half a circle so a near full sweep
+			//is rounding on an arc too short to split.
+			if (sweep > 1.5 * PI) sweep = 0;
+
+			double step = 2 * std::acos((std::max)(-1.0, 1.0 - tolerance / radius));
+			int segments = (std::max)(1, int(std::ceil(sweep / step)));
+			if (curve->orientation() != CGAL::COUNTERCLOCKWISE) sweep = -sweep;
+
+			for (int i = 1; i < segments; i++)
+			{
+				double a = a0 + sweep * i / segments;
+				out.points.push_back({ float(cx + radius * std::cos(a)), float(cy + radius * std::sin(a)) });
+			}
+		}
+
+		out.ringSizes.push_back(int(out.points.size() - start));
+	}
+
+	void AddOffsetPolygon(const OffsetPolygonWithHoles& polygon, double tolerance, PolygonBuffer2f& out)
+	{
+		out.ringOffsets.push_back(int(out.ringSizes.size()));
+		out.polygonRings.push_back(1 + int(polygon.number_of_holes()));
+
+		AddOffsetRing(polygon.outer_boundary(), tolerance, out);
+		for (auto hole = polygon.holes_begin(); hole != polygon.holes_end(); ++hole)
+			AddOffsetRing(*hole, tolerance, out);
+	}
+
+	//Grows the polygon by the radius, or shrinks it if negative. Insetting
+	//shrinks the outer boundary and removes the holes grown by the radius.
+	void Offset(const PolygonWithHoles& pwh, double radius, double tolerance, PolygonBuffer2f& out)
+	{
+		if (radius > 0)
+		{
+			AddOffsetPolygon(CGAL::approximated_offset_2(pwh, radius, tolerance), tolerance, out);
+			return;
+		}
+
+		if (radius == 0)
+		{
+			out.AddPolygonWithHoles(pwh);
+			return;
+		}
+
+		vector<OffsetPolygon> insets;
+		CGAL::approximated_inset_2(pwh.outer_boundary(), -radius, tolerance, back_inserter(insets));
+
+		OffsetPolygonSet set;
+		for (auto& inset : insets)
+			set.insert(inset);
+
+		for (auto hole = pwh.holes_begin(); hole != pwh.holes_end(); ++hole)
+		{
+			Polygon boundary = *hole;
+			boundary.reverse_orientation();
+			set.difference(CGAL::approximated_offset_2(boundary, -radius, tolerance));
+		}
+
+		vector<OffsetPolygonWithHoles> polygons;
+		set.polygons_with_holes(back_inserter(polygons));
+
+		for (auto& polygon : polygons)
+			AddOffsetPolygon(polygon, tolerance, out);
+	}
 
 	void LoadPolygonPoints(Polygon& polygon, const vector<Point>& points)
 	{
@@ -50,6 +383,9 @@ namespace MinkowskiSums2
 		B.clear();
 		sum.clear();
 		holes.clear();
+		strategy = AUTO;
+		batchOutput.Clear();
+		batchOffsets.clear();
 	}
 
 	CGALWRAPPERAPI void CALLCON MinkowskiSums2_Release()
@@ -58,16 +394,22 @@ namespace MinkowskiSums2
 		B = Polygon();
 		sum = PolygonWithHoles();
 		holes.resize(0);
+		batchOutput.Release();
+		batchOffsets.resize(0);
 	}
 
 	CGALWRAPPERAPI CGALResult CALLCON MinkowskiSums2_ComputeSum()
+	{
+		return MinkowskiSums2_ComputeSumWith(AUTO);
+	}
+
+	//Convex operands are merged in linear time. Otherwise the auto strategy
+	//picks from the operand sizes and reflex vertex counts.
+	CGALWRAPPERAPI CGALResult CALLCON MinkowskiSums2_ComputeSumWith(int requested)
 	{
 		try
 		{
-			//CGAL::Polygon_triangulation_decomposition_2<Kernel> pt_decomp;
-			CGAL::Small_side_angle_bisector_decomposition_2<Kernel> ssab_decomp;
-
-			sum = CGAL::minkowski_sum_2(A, B, ssab_decomp);
+			sum = ComputeSum(A, B, requested, strategy);
 			holes = vector<PolygonWithHoles>(sum.holes_begin(), sum.holes_end());
 
 			return CGAL_SUCCESS;
@@ -78,6 +420,12 @@ namespace MinkowskiSums2
 		}
 	}
 
+	//The strategy the last sum ran with.
+	CGALWRAPPERAPI int CALLCON MinkowskiSums2_GetStrategy()
+	{
+		return strategy;
+	}
+
 	CGALWRAPPERAPI int CALLCON MinkowskiSums2_NumPolygonPoints()
 	{
 		return int(sum.outer_boundary().size());
@@ -113,4 +461,132 @@ namespace MinkowskiSums2
 		return{ x, y };
 	}
 
+	//Sums one shape B against many obstacles. B is reflected through the origin
+	//first if asked, for configuration space obstacles, and is decomposed once
+	//for the whole batch, with the pieces used for convex obstacles. The sums
+	//can be unioned into one set of polygons whose complement is the free space.
+	CGALWRAPPERAPI CGALResult CALLCON MinkowskiSums2_BatchSum2f(const Point2f* inB, int bSize, BOOL reflectB, const Point2f* inPoints, const int* inRingSizes, const int* inPolygonRings, int numPolygons, BOOL unionSums, PolygonBufferDescriptor& descriptor)
+	{
+		try
+		{
+			batchOutput.Clear();
+			batchOffsets.clear();
+
+			vector<Point2f> pointsB(inB, inB + bSize);
+			if (reflectB)
+			{
+				for (auto& p : pointsB)
+					p = { -p.x, -p.y };
+			}
+
+			vector<Point> points = ToPointArray2<Point, Point2f>(pointsB.data(), bSize);
+			vector<vector<Point2f>> pieces = DecomposeOnce(Polygon(points.begin(), points.end()));
+
+			PolygonBuffer2f input;
+			input.Load(inPoints, inRingSizes, inPolygonRings, numPolygons);
+
+			vector<vector<PolygonWithHoles>> sums(input.NumPolygons());
+
+			Utility::ParallelFor(input.NumPolygons(), [&](int i)
+			{
+				PolygonWithHoles a = input.ToPolygon<PolygonWithHoles>(i);
+				SumPieces(a, pointsB, pieces, sums[i]);
+			});
+
+			if (unionSums)
+			{
+				vector<PolygonWithHoles> all, joined;
+				for (auto& polygons : sums)
+					all.insert(all.end(), polygons.begin(), polygons.end());
+
+				CGAL::join(all.begin(), all.end(), back_inserter(joined));
+
+				for (auto& polygon : joined)
+					batchOutput.AddPolygonWithHoles(polygon);
+			}
+			else
+			{
+				for (auto& polygons : sums)
+				{
+					batchOffsets.push_back(batchOutput.NumPolygons());
+
+					for (auto& polygon : polygons)
+						batchOutput.AddPolygonWithHoles(polygon);
+				}
+
+				batchOffsets.push_back(batchOutput.NumPolygons());
+			}
+
+			descriptor = batchOutput.Descriptor();
+			return CGAL_SUCCESS;
+		}
+		catch (...)
+		{
+			batchOutput.Clear();
+			batchOffsets.clear();
+			descriptor = batchOutput.Descriptor();
+			return CGAL_ERROR;
+		}
+	}
+
+	//Copies out the batch sums and, if they were not unioned, where each
+	//obstacle's sums start plus the total.
+	CGALWRAPPERAPI void CALLCON MinkowskiSums2_GetBatchSum2f(Point2f* outPoints, int* outRingSizes, int* outPolygonRings, int* outPolygonOffsets)
+	{
+		batchOutput.CopyTo(outPoints, outRingSizes, outPolygonRings);
+
+		if (outPolygonOffsets != nullptr)
+			std::copy(batchOffsets.begin(), batchOffsets.end(), outPolygonOffsets);
+	}
+
+	//Offsets each polygon by the radius, shrinking it if negative, without a
+	//disk shaped Minkowski sum. The arcs of the offset are output as chords
+	//that stay within the tolerance.
+	CGALWRAPPERAPI CGALResult CALLCON MinkowskiSums2_Offset2f(const Point2f* inPoints, const int* inRingSizes, const int* inPolygonRings, int numPolygons, double radius, double tolerance, PolygonBufferDescriptor& descriptor)
+	{
+		try
+		{
+			batchOutput.Clear();
+			batchOffsets.clear();
+			descriptor = batchOutput.Descriptor();
+
+			if (tolerance <= 0) return CGAL_ERROR;
+
+			PolygonBuffer2f input;
+			input.Load(inPoints, inRingSizes, inPolygonRings, numPolygons);
+
+			vector<PolygonBuffer2f> results(input.NumPolygons());
+
+			Utility::ParallelFor(input.NumPolygons(), [&](int i)
+			{
+				PolygonWithHoles pwh = input.ToPolygon<PolygonWithHoles>(i);
+				Offset(pwh, radius, tolerance, results[i]);
+			});
+
+			for (auto& result : results)
+			{
+				batchOffsets.push_back(batchOutput.NumPolygons());
+				batchOutput.Append(result);
+			}
+
+			batchOffsets.push_back(batchOutput.NumPolygons());
+
+			descriptor = batchOutput.Descriptor();
+			return CGAL_SUCCESS;
+		}
+		catch (...)
+		{
+			batchOutput.Clear();
+			batchOffsets.clear();
+			descriptor = batchOutput.Descriptor();
+			return CGAL_ERROR;
+		}
+	}
+
+	//Copies out the offsets and where each input polygon's offsets start.
+	CGALWRAPPERAPI void CALLCON MinkowskiSums2_GetOffset2f(Point2f* outPoints, int* outRingSizes, int* outPolygonRings, int* outPolygonOffsets)
+	{
+		MinkowskiSums2_GetBatchSum2f(outPoints, outRingSizes, outPolygonRings, outPolygonOffsets);
+	}
+
 }
\ No newline at end of file
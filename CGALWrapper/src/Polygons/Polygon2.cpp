@@ -1,11 +1,17 @@
 
 #include "stdafx.h"
 #include "Polygons/Polygon2.h"
+#include "Primatives/PolygonBuffer2.h"
+#include "Utility/ParallelFor.h"
 
 #include <CGAL/Exact_predicates_inexact_constructions_kernel.h>
 #include <CGAL/Polygon_2.h>
 #include <CGAL/enum.h>
 
+#include <cmath>
+#include <set>
+#include <algorithm>
+
 using namespace std;
 
 namespace Polygon2
@@ -17,6 +23,64 @@ namespace Polygon2
 
 	Polygon polygon;
 
+	PolygonBuffer2f hierarchy;
+	vector<int> depths, parents;
+
+	//A non vertical ring edge stored left to right. Above is true if the
+	//ring's interior is above the edge.
+	struct SweepEdge
+	{
+		double x0, y0, x1, y1;
+		int ring;
+		bool above;
+
+		double YAt(double x) const
+		{
+			if (x1 == x0) return y0;
+			return y0 + (y1 - y0) * (x - x0) / (x1 - x0);
+		}
+	};
+
+	//Orders the edges crossing the sweep line from bottom to top. Ring edges
+	//do not cross so comparing where both are defined is enough, falling
+	//back to the right side for edges leaving the same point.
+	struct SweepOrder
+	{
+		bool operator()(const SweepEdge* a, const SweepEdge* b) const
+		{
+			if (a == b) return false;
+
+			double x = (std::max)(a->x0, b->x0);
+			double ya = a->YAt(x), yb = b->YAt(x);
+			if (ya != yb) return ya < yb;
+
+			x = (std::min)(a->x1, b->x1);
+			ya = a->YAt(x);
+			yb = b->YAt(x);
+			if (ya != yb) return ya < yb;
+
+			return a < b;
+		}
+	};
+
+	struct SweepEvent
+	{
+		double x, y;
+		int type;
+		int index;
+
+		bool operator<(const SweepEvent& e) const
+		{
+			if (x != e.x) return x < e.x;
+			if (type != e.type) return type < e.type;
+			return y < e.y;
+		}
+	};
+
+	//At equal x parents are found before edges ending there are removed, so a
+	//leftmost vertex level with a vertex of the ring around it still sees it.
+	enum { FIND_PARENT, REMOVE_EDGE, INSERT_EDGE };
+
 	CGALWRAPPERAPI void CALLCON Polygon2_LoadPoints2f(const Point2f* inPoints, int inSize)
 	{
 		vector<Point> points = ToPointArray2<Point, Point2f>(inPoints, inSize);
@@ -26,6 +90,9 @@ namespace Polygon2
 	CGALWRAPPERAPI void CALLCON Polygon2_Release()
 	{
 		polygon = Polygon();
+		hierarchy.Release();
+		depths.resize(0);
+		parents.resize(0);
 	}
 
 	CGALWRAPPERAPI BOOL CALLCON Polygon2_IsSimple()
@@ -48,4 +115,293 @@ namespace Polygon2
 		return float(polygon.area());
 	}
 
+	//Area, perimeter, centroid and box of all the rings in one pass in double
+	//precision. Holes are clockwise so their area and moments subtract.
+	void Measure(const PolygonBuffer2f& buffer, int polygon, PolygonProperties& properties)
+	{
+		double area = 0, perimeter = 0, mx = 0, my = 0;
+		double sx = 0, sy = 0;
+		int count = 0;
+
+		int first = buffer.ringOffsets[polygon];
+		for (int r = first; r < first + buffer.polygonRings[polygon]; r++)
+		{
+			const Point2f* p = buffer.RingPoints(r);
+			int n = buffer.ringSizes[r];
+
+			for (int i = 0; i < n; i++)
+			{
+				double x0 = p[i].x, y0 = p[i].y;
+				double x1 = p[(i + 1) % n].x, y1 = p[(i + 1) % n].y;
+
+				double cross = x0 * y1 - x1 * y0;
+				area += cross;
+				mx += (x0 + x1) * cross;
+				my += (y0 + y1) * cross;
+				perimeter += std::sqrt((x1 - x0) * (x1 - x0) + (y1 - y0) * (y1 - y0));
+
+				sx += x0;
+				sy += y0;
+			}
+
+			count += n;
+		}
+
+		properties.area = area * 0.5;
+		properties.perimeter = perimeter;
+
+		if (area != 0)
+		{
+			properties.centroidX = mx / (3 * area);
+			properties.centroidY = my / (3 * area);
+		}
+		else if (count > 0)
+		{
+			properties.centroidX = sx / count;
+			properties.centroidY = sy / count;
+		}
+		else
+		{
+			properties.centroidX = 0;
+			properties.centroidY = 0;
+		}
+
+		CGAL::Bbox_2 box = buffer.Bbox(polygon);
+		properties.xmin = float(box.xmin());
+		properties.ymin = float(box.ymin());
+		properties.xmax = float(box.xmax());
+		properties.ymax = float(box.ymax());
+	}
+
+	//The linear checks run first. The orientation is taken from the sign of
+	//the area as orientation_2 requires a simple polygon. A convex outer
+	//boundary without holes is already known to be simple so the sweep is
+	//only run on the rest.
+	void Classify(const PolygonBuffer2f& buffer, int polygon, BOOL checkSimple, PolygonProperties& properties)
+	{
+		int first = buffer.ringOffsets[polygon];
+		int rings = buffer.polygonRings[polygon];
+
+		properties.simple = checkSimple ? 1 : -1;
+		properties.convex = 0;
+		properties.orientation = CGAL::COLLINEAR;
+
+		if (buffer.ringSizes[first] < 3)
+		{
+			if (checkSimple) properties.simple = 0;
+			return;
+		}
+
+		vector<Point> outer = ToPointArray2<Point, Point2f>(buffer.RingPoints(first), buffer.ringSizes[first]);
+
+		properties.convex = rings == 1 && CGAL::is_convex_2(outer.begin(), outer.end(), K());
+		properties.orientation = CGAL::sign(properties.area);
+
+		if (!checkSimple || properties.convex) return;
+
+		properties.simple = CGAL::is_simple_2(outer.begin(), outer.end(), K());
+
+		for (int r = first + 1; r < first + rings && properties.simple; r++)
+		{
+			vector<Point> hole = ToPointArray2<Point, Point2f>(buffer.RingPoints(r), buffer.ringSizes[r]);
+			properties.simple = hole.size() >= 3 && CGAL::is_simple_2(hole.begin(), hole.end(), K());
+		}
+	}
+
+	//Evaluates many polygons in one call, in parallel. The simplicity sweep is
+	//O(n log n) so only runs if asked for.
+	CGALWRAPPERAPI CGALResult CALLCON Polygon2_BatchProperties2f(const Point2f* inPoints, const int* inRingSizes, const int* inPolygonRings, int numPolygons, BOOL checkSimple, PolygonProperties* outProperties)
+	{
+		try
+		{
+			PolygonBuffer2f input;
+			input.Load(inPoints, inRingSizes, inPolygonRings, numPolygons);
+
+			Utility::ParallelFor(input.NumPolygons(), [&](int i)
+			{
+				Measure(input, i, outProperties[i]);
+				Classify(input, i, checkSimple, outProperties[i]);
+			});
+
+			return CGAL_SUCCESS;
+		}
+		catch (...)
+		{
+			return CGAL_ERROR;
+		}
+	}
+
+	double RingArea(const Point2f* p, int n)
+	{
+		double area = 0;
+		for (int i = 0; i < n; i++)
+			area += double(p[i].x) * p[(i + 1) % n].y - double(p[(i + 1) % n].x) * p[i].y;
+
+		return area * 0.5;
+	}
+
+	//Sweeps left to right. At each ring's leftmost vertex the nearest edge
+	//below belongs to the ring that contains it if that ring's interior is
+	//above the edge, otherwise to a sibling whose parent is shared. A parent
+	//is always reached before its children so depths resolve as they go.
+	void FindParents(const PolygonBuffer2f& rings, const vector<double>& areas, vector<int>& outParents, vector<int>& outDepths)
+	{
+		int numRings = int(rings.ringSizes.size());
+		vector<SweepEdge> edges;
+		vector<SweepEvent> events;
+
+		for (int r = 0; r < numRings; r++)
+		{
+			const Point2f* p = rings.RingPoints(r);
+			int n = rings.ringSizes[r];
+			if (n == 0) continue;
+
+			int leftmost = 0;
+			for (int i = 0; i < n; i++)
+			{
+				const Point2f& a = p[i];
+				const Point2f& b = p[(i + 1) % n];
+
+				if (a.x < p[leftmost].x || (a.x == p[leftmost].x && a.y < p[leftmost].y))
+					leftmost = i;
+
+				if (a.x == b.x) continue;
+
+				SweepEdge edge;
+				bool right = a.x < b.x;
+				const Point2f& l = right ? a : b;
+				const Point2f& h = right ? b : a;
+
+				edge.x0 = l.x;
+				edge.y0 = l.y;
+				edge.x1 = h.x;
+				edge.y1 = h.y;
+				edge.ring = r;
+				edge.above = right == (areas[r] >= 0);
+				edges.push_back(edge);
+			}
+
+			events.push_back({ double(p[leftmost].x), double(p[leftmost].y), FIND_PARENT, r });
+		}
+
+		for (int i = 0; i < int(edges.size()); i++)
+		{
+			events.push_back({ edges[i].x0, edges[i].y0, INSERT_EDGE, i });
+			events.push_back({ edges[i].x1, edges[i].y1, REMOVE_EDGE, i });
+		}
+
+		std::sort(events.begin(), events.end());
+
+		outParents.assign(numRings, -1);
+		outDepths.assign(numRings, 0);
+		std::set<const SweepEdge*, SweepOrder> status;
+
+		for (auto& e : events)
+		{
+			if (e.type == INSERT_EDGE)
+			{
+				status.insert(&edges[e.index]);
+			}
+			else if (e.type == REMOVE_EDGE)
+			{
+				status.erase(&edges[e.index]);
+			}
+			else
+			{
+				SweepEdge probe = { e.x, e.y, e.x, e.y, -1, false };
+
+				auto below = status.lower_bound(&probe);
+				if (below == status.begin()) continue;
+				--below;
+
+				const SweepEdge* edge = *below;
+				int parent = edge->above ? edge->ring : outParents[edge->ring];
+
+				outParents[e.index] = parent;
+				outDepths[e.index] = (parent == -1) ? 0 : outDepths[parent] + 1;
+			}
+		}
+	}
+
+	//Sorts unordered rings into polygons with holes. Rings must be simple and
+	//not cross each other. Rings at even depth become outer boundaries and
+	//rings at odd depth holes of their parent, reoriented to counter clockwise
+	//and clockwise. O(n log n) in the total number of edges.
+	CGALWRAPPERAPI CGALResult CALLCON Polygon2_BuildHierarchy2f(const Point2f* inPoints, const int* inRingSizes, int numRings, PolygonBufferDescriptor& descriptor)
+	{
+		try
+		{
+			hierarchy.Clear();
+			depths.clear();
+			parents.clear();
+
+			vector<int> polygonRings(numRings, 1);
+
+			PolygonBuffer2f rings;
+			rings.Load(inPoints, inRingSizes, polygonRings.data(), numRings);
+
+			vector<double> areas(numRings);
+			for (int r = 0; r < numRings; r++)
+				areas[r] = RingArea(rings.RingPoints(r), rings.ringSizes[r]);
+
+			FindParents(rings, areas, parents, depths);
+
+			vector<vector<int>> holes(numRings);
+			for (int r = 0; r < numRings; r++)
+			{
+				if (depths[r] % 2 == 1) holes[parents[r]].push_back(r);
+			}
+
+			auto addRing = [&](int r, bool ccw)
+			{
+				const Point2f* p = rings.RingPoints(r);
+				int n = rings.ringSizes[r];
+
+				hierarchy.pointOffsets.push_back(int(hierarchy.points.size()));
+				hierarchy.ringSizes.push_back(n);
+
+				if ((areas[r] >= 0) == ccw)
+					hierarchy.points.insert(hierarchy.points.end(), p, p + n);
+				else
+					hierarchy.points.insert(hierarchy.points.end(), std::reverse_iterator<const Point2f*>(p + n), std::reverse_iterator<const Point2f*>(p));
+			};
+
+			for (int r = 0; r < numRings; r++)
+			{
+				if (depths[r] % 2 == 1) continue;
+
+				hierarchy.ringOffsets.push_back(int(hierarchy.ringSizes.size()));
+				hierarchy.polygonRings.push_back(1 + int(holes[r].size()));
+
+				addRing(r, true);
+				for (int hole : holes[r])
+					addRing(hole, false);
+			}
+
+			descriptor = hierarchy.Descriptor();
+			return CGAL_SUCCESS;
+		}
+		catch (...)
+		{
+			hierarchy.Clear();
+			depths.clear();
+			parents.clear();
+			descriptor = hierarchy.Descriptor();
+			return CGAL_ERROR;
+		}
+	}
+
+	//Copies out the polygons with holes and, for each input ring, its depth
+	//and the index of the ring directly containing it or -1.
+	CGALWRAPPERAPI void CALLCON Polygon2_GetHierarchy2f(Point2f* outPoints, int* outRingSizes, int* outPolygonRings, int* outDepths, int* outParents)
+	{
+		hierarchy.CopyTo(outPoints, outRingSizes, outPolygonRings);
+
+		if (outDepths != nullptr)
+			std::copy(depths.begin(), depths.end(), outDepths);
+
+		if (outParents != nullptr)
+			std::copy(parents.begin(), parents.end(), outParents);
+	}
+
 }
\ No newline at end of file
@@ -1,9 +1,15 @@
 
 #include "stdafx.h"
 #include "Polygons/PolygonBoolean2.h"
+#include "Primatives/PolygonBuffer2.h"
+#include "Utility/ParallelFor.h"
 
 #include <CGAL/Exact_predicates_exact_constructions_kernel.h>
 #include <CGAL/Boolean_set_operations_2.h>
+#include <CGAL/box_intersection_d.h>
+
+#include <cmath>
+#include <algorithm>
 
 using namespace std;
 
@@ -14,6 +20,7 @@ namespace PolygonBoolean2
 	typedef Kernel::Point_2 Point;
 	typedef CGAL::Polygon_2<Kernel> Polygon;
 	typedef CGAL::Polygon_with_holes_2<Kernel> PolygonWithHoles;
+	typedef CGAL::Box_intersection_d::Box_with_handle_d<double, 2, const int*> Box;
 
 	PolygonWithHoles A, B;
 	vector<PolygonWithHoles> polygons;
@@ -21,6 +28,31 @@ namespace PolygonBoolean2
 	PolygonWithHoles focusPolygon;
 	vector<PolygonWithHoles> focusHoles;
 
+	PolygonBuffer2f batchA, batchB;
+	vector<PolygonPair> batchPairs;
+
+	PolygonBuffer2f gridTiles;
+	vector<int> tileOffsets, tileSources;
+
+	struct TileGrid
+	{
+		double x, y;
+		double width, height;
+		int columns, rows;
+
+		CGAL::Bbox_2 Tile(int column, int row) const
+		{
+			return CGAL::Bbox_2(x + column * width, y + row * height, x + (column + 1) * width, y + (row + 1) * height);
+		}
+	};
+
+	//The clipped pieces of one polygon and the tile each is in.
+	struct ClippedPolygon
+	{
+		PolygonBuffer2f pieces;
+		vector<int> tiles;
+	};
+
 	void LoadPolygonPoints(PolygonWithHoles& polygon, const vector<Point>& points)
 	{
 		polygon = PolygonWithHoles(Polygon(points.begin(), points.end()));
@@ -57,6 +89,12 @@ namespace PolygonBoolean2
 		focusPolygon.clear();
 		focusHoles.clear();
 		polygons.clear();
+		batchA.Clear();
+		batchB.Clear();
+		batchPairs.clear();
+		gridTiles.Clear();
+		tileOffsets.clear();
+		tileSources.clear();
 	}
 
 	CGALWRAPPERAPI void CALLCON Boolean2_Release()
@@ -66,6 +104,12 @@ namespace PolygonBoolean2
 		focusPolygon = PolygonWithHoles();
 		focusHoles.resize(0);
 		polygons.resize(0);
+		batchA.Release();
+		batchB.Release();
+		batchPairs.resize(0);
+		gridTiles.Release();
+		tileOffsets.resize(0);
+		tileSources.resize(0);
 	}
 
 	CGALWRAPPERAPI BOOL CALLCON Boolean2_DoIntersect()
@@ -199,4 +243,563 @@ namespace PolygonBoolean2
 		return{ x, y };
 	}
 
+	double Area(const PolygonWithHoles& polygon)
+	{
+		double area = CGAL::to_double(polygon.outer_boundary().area());
+
+		for (auto hole = polygon.holes_begin(); hole != polygon.holes_end(); ++hole)
+			area += CGAL::to_double(hole->area());
+
+		return area;
+	}
+
+	void MakeBoxes(const PolygonBuffer2f& buffer, const vector<int>& indices, vector<Box>& boxes)
+	{
+		int count = buffer.NumPolygons();
+		boxes.reserve(count);
+
+		for (int i = 0; i < count; i++)
+			boxes.push_back(Box(buffer.Bbox(i), &indices[i]));
+	}
+
+	CGALWRAPPERAPI void CALLCON Boolean2_Batch_A_LoadPolygons2f(const Point2f* inPoints, const int* inRingSizes, const int* inPolygonRings, int numPolygons)
+	{
+		batchA.Load(inPoints, inRingSizes, inPolygonRings, numPolygons);
+	}
+
+	CGALWRAPPERAPI void CALLCON Boolean2_Batch_B_LoadPolygons2f(const Point2f* inPoints, const int* inRingSizes, const int* inPolygonRings, int numPolygons)
+	{
+		batchB.Load(inPoints, inRingSizes, inPolygonRings, numPolygons);
+	}
+
+	CGALWRAPPERAPI int CALLCON Boolean2_BatchDoIntersect(BOOL computeArea)
+	{
+		try
+		{
+			batchPairs.clear();
+
+			int countA = batchA.NumPolygons();
+			int countB = batchB.NumPolygons();
+			if (countA == 0 || countB == 0) return 0;
+
+			vector<int> indicesA(countA), indicesB(countB);
+			for (int i = 0; i < countA; i++) indicesA[i] = i;
+			for (int i = 0; i < countB; i++) indicesB[i] = i;
+
+			vector<Box> boxesA, boxesB;
+			MakeBoxes(batchA, indicesA, boxesA);
+			MakeBoxes(batchB, indicesB, boxesB);
+
+			vector<PolygonPair> candidates;
+			auto report = [&](const Box& a, const Box& b)
+			{
+				candidates.push_back({ *a.handle(), *b.handle(), 0.0 });
+			};
+
+			CGAL::box_intersection_d(boxesA.begin(), boxesA.end(), boxesB.begin(), boxesB.end(), report);
+
+			sort(candidates.begin(), candidates.end(), [](const PolygonPair& p0, const PolygonPair& p1)
+			{
+				return p0.a < p1.a || (p0.a == p1.a && p0.b < p1.b);
+			});
+
+			//Exact kernel objects are not shared between threads so each
+			//candidate builds its own polygons from the float input.
+			vector<char> hits(candidates.size(), 0);
+
+			Utility::ParallelFor(int(candidates.size()), [&](int i)
+			{
+				PolygonWithHoles a = batchA.ToPolygon<PolygonWithHoles>(candidates[i].a);
+				PolygonWithHoles b = batchB.ToPolygon<PolygonWithHoles>(candidates[i].b);
+
+				if (computeArea)
+				{
+					vector<PolygonWithHoles> intersection;
+					CGAL::intersection(a, b, back_inserter(intersection));
+
+					double area = 0;
+					for (auto& polygon : intersection)
+						area += Area(polygon);
+
+					candidates[i].area = area;
+					hits[i] = intersection.size() > 0;
+				}
+				else
+				{
+					hits[i] = CGAL::do_intersect(a, b);
+				}
+			});
+
+			for (size_t i = 0; i < candidates.size(); i++)
+			{
+				if (hits[i]) batchPairs.push_back(candidates[i]);
+			}
+
+			return int(batchPairs.size());
+		}
+		catch (...)
+		{
+			batchPairs.clear();
+			return 0;
+		}
+	}
+
+	CGALWRAPPERAPI void CALLCON Boolean2_GetBatchPairs(PolygonPair* outPairs, int size)
+	{
+		int count = (std::min)(size, int(batchPairs.size()));
+		copy(batchPairs.begin(), batchPairs.begin() + count, outPairs);
+	}
+
+	//Clips the ring to the half plane where the coordinate along the axis is
+	//on the kept side of the value. Vertices on the line are kept as they are
+	//and only edges strictly crossing it are cut, so a vertex on the line is
+	//not emitted twice.
+	void ClipRing(vector<Point2f>& ring, int axis, double value, bool keepBelow)
+	{
+		vector<Point2f> clipped;
+		clipped.reserve(ring.size() + 4);
+
+		int n = int(ring.size());
+
+		auto coord = [&](const Point2f& p) { return double(axis == 0 ? p.x : p.y); };
+		auto side = [&](const Point2f& p)
+		{
+			double d = keepBelow ? value - coord(p) : coord(p) - value;
+			return (d > 0) ? 1 : ((d < 0) ? -1 : 0);
+		};
+
+		for (int i = 0; i < n; i++)
+		{
+			const Point2f& a = ring[i];
+			const Point2f& b = ring[(i + 1) % n];
+			int sideA = side(a), sideB = side(b);
+
+			if (sideA >= 0) clipped.push_back(a);
+
+			if (sideA * sideB < 0)
+			{
+				double t = (value - coord(a)) / (coord(b) - coord(a));
+				double x = a.x + (b.x - a.x) * t;
+				double y = a.y + (b.y - a.y) * t;
+
+				if (axis == 0) x = value;
+				else y = value;
+
+				clipped.push_back({ float(x), float(y) });
+			}
+		}
+
+		//Rounding the cut to float can still land on a neighbouring vertex.
+		auto same = [](const Point2f& a, const Point2f& b) { return a.x == b.x && a.y == b.y; };
+		clipped.erase(unique(clipped.begin(), clipped.end(), same), clipped.end());
+
+		while (clipped.size() > 1 && same(clipped.front(), clipped.back()))
+			clipped.pop_back();
+
+		ring.swap(clipped);
+	}
+
+	bool InTile(const Point2f& p, const CGAL::Bbox_2& tile)
+	{
+		return p.x >= tile.xmin() && p.x <= tile.xmax() && p.y >= tile.ymin() && p.y <= tile.ymax();
+	}
+
+	//True if the ring runs from a to b and straight back along a tile side.
+	bool IsSpike(const Point2f& a, const Point2f& b, const Point2f& c)
+	{
+		if (a.x == b.x && b.x == c.x)
+			return (double(b.y) - a.y) * (double(c.y) - b.y) <= 0;
+
+		if (a.y == b.y && b.y == c.y)
+			return (double(b.x) - a.x) * (double(c.x) - b.x) <= 0;
+
+		return false;
+	}
+
+	//Clipping a side leaves a bridge to every piece beyond it. Bridges to
+	//pieces the later sides clipped away end in spikes, which are removed.
+	void RemoveSpikes(vector<Point2f>& ring)
+	{
+		vector<Point2f> kept;
+		kept.reserve(ring.size());
+
+		for (auto& p : ring)
+		{
+			kept.push_back(p);
+
+			while (kept.size() >= 3 && IsSpike(kept[kept.size() - 3], kept[kept.size() - 2], kept.back()))
+				kept.erase(kept.end() - 2);
+		}
+
+		bool removed = true;
+		while (removed && kept.size() >= 3)
+		{
+			size_t n = kept.size();
+			removed = true;
+
+			if (IsSpike(kept[n - 2], kept[n - 1], kept[0]))
+				kept.pop_back();
+			else if (IsSpike(kept[n - 1], kept[0], kept[1]))
+				kept.erase(kept.begin());
+			else
+				removed = false;
+		}
+
+		ring.swap(kept);
+	}
+
+	//Where a concave ring leaves the tile and comes back, Sutherland-Hodgman
+	//joins the pieces with edges running along the tile side there and back.
+	//Returns true if two edges along the same side overlap, or pieces touch
+	//where a vertex on a side is repeated or lies inside an edge along it.
+	bool HasBridgeEdges(const vector<Point2f>& ring, const CGAL::Bbox_2& tile)
+	{
+		float values[4] = { float(tile.xmin()), float(tile.xmax()), float(tile.ymin()), float(tile.ymax()) };
+		int n = int(ring.size());
+
+		vector<pair<float, float>> spans;
+		vector<float> vertices;
+
+		for (int side = 0; side < 4; side++)
+		{
+			int axis = side / 2;
+			spans.clear();
+			vertices.clear();
+
+			for (int i = 0; i < n; i++)
+			{
+				const Point2f& a = ring[i];
+				const Point2f& b = ring[(i + 1) % n];
+
+				float ca = (axis == 0) ? a.x : a.y, cb = (axis == 0) ? b.x : b.y;
+				float ta = (axis == 0) ? a.y : a.x, tb = (axis == 0) ? b.y : b.x;
+
+				if (ca != values[side]) continue;
+				vertices.push_back(ta);
+
+				if (cb == values[side])
+					spans.push_back({ (std::min)(ta, tb), (std::max)(ta, tb) });
+			}
+
+			sort(vertices.begin(), vertices.end());
+			if (adjacent_find(vertices.begin(), vertices.end()) != vertices.end())
+				return true;
+
+			sort(spans.begin(), spans.end());
+
+			for (size_t i = 1; i < spans.size(); i++)
+			{
+				if (spans[i].first < spans[i - 1].second)
+					return true;
+			}
+
+			//The spans are now disjoint and sorted.
+			for (float t : vertices)
+			{
+				auto span = upper_bound(spans.begin(), spans.end(), make_pair(t, t));
+				if (span != spans.begin() && t < (span - 1)->second && t > (span - 1)->first)
+					return true;
+			}
+		}
+
+		return false;
+	}
+
+	//Sutherland-Hodgman against the four sides of the tile. Returns false if
+	//the clipped ring has bridge edges along a side, as it is then several
+	//pieces joined along the tile boundary and not a valid ring.
+	bool ClipRingToTile(vector<Point2f>& ring, const CGAL::Bbox_2& tile)
+	{
+		double values[4] = { tile.xmin(), tile.xmax(), tile.ymin(), tile.ymax() };
+
+		for (int side = 0; side < 4 && ring.size() > 0; side++)
+			ClipRing(ring, side / 2, values[side], side % 2 == 1);
+
+		RemoveSpikes(ring);
+
+		//Rings only touching the tile clip to zero area.
+		double area = 0;
+		for (size_t i = 0; i < ring.size(); i++)
+		{
+			const Point2f& a = ring[i];
+			const Point2f& b = ring[(i + 1) % ring.size()];
+			area += double(a.x) * b.y - double(b.x) * a.y;
+		}
+
+		if (ring.size() < 3 || area == 0)
+		{
+			ring.clear();
+			return true;
+		}
+
+		return !HasBridgeEdges(ring, tile);
+	}
+
+	//Liang-Barsky test of the segment against the closed tile.
+	bool SegmentHitsTile(const Point2f& a, const Point2f& b, const CGAL::Bbox_2& tile)
+	{
+		double dx = double(b.x) - a.x, dy = double(b.y) - a.y;
+		double p[4] = { -dx, dx, -dy, dy };
+		double q[4] = { a.x - tile.xmin(), tile.xmax() - a.x, a.y - tile.ymin(), tile.ymax() - a.y };
+		double t0 = 0, t1 = 1;
+
+		for (int i = 0; i < 4; i++)
+		{
+			if (p[i] == 0)
+			{
+				if (q[i] < 0) return false;
+				continue;
+			}
+
+			double t = q[i] / p[i];
+			if (p[i] < 0)
+			{
+				if (t > t1) return false;
+				t0 = (std::max)(t0, t);
+			}
+			else
+			{
+				if (t < t0) return false;
+				t1 = (std::min)(t1, t);
+			}
+		}
+
+		return true;
+	}
+
+	bool RingContains(const Point2f* p, int n, double x, double y)
+	{
+		bool inside = false;
+		for (int i = 0, j = n - 1; i < n; j = i++)
+		{
+			if ((p[i].y > y) != (p[j].y > y) && x < p[j].x + (y - p[j].y) * (double(p[i].x) - p[j].x) / (double(p[i].y) - p[j].y))
+				inside = !inside;
+		}
+
+		return inside;
+	}
+
+	enum HoleInTile { HOLE_OUTSIDE, HOLE_INSIDE, HOLE_CROSSES, HOLE_COVERS };
+
+	//A hole whose boundary misses the tile either covers all of it or none.
+	HoleInTile ClassifyHole(const Point2f* p, int n, const CGAL::Bbox_2& tile)
+	{
+		bool inside = true;
+		for (int i = 0; i < n && inside; i++)
+			inside = InTile(p[i], tile);
+
+		if (inside) return HOLE_INSIDE;
+
+		for (int i = 0; i < n; i++)
+		{
+			if (SegmentHitsTile(p[i], p[(i + 1) % n], tile))
+				return HOLE_CROSSES;
+		}
+
+		double x = (tile.xmin() + tile.xmax()) * 0.5;
+		double y = (tile.ymin() + tile.ymax()) * 0.5;
+
+		return RingContains(p, n, x, y) ? HOLE_COVERS : HOLE_OUTSIDE;
+	}
+
+	//Clips one polygon against every tile its box overlaps. The outer ring is
+	//clipped with Sutherland-Hodgman and holes are kept, dropped or empty the
+	//tile depending on where they lie. The exact intersection is only used if
+	//the clipped outer ring is several pieces in that tile or a hole's
+	//boundary passes through the tile, where the clipped rings would not form
+	//a valid polygon.
+	void ClipToTiles(const PolygonBuffer2f& input, int polygon, const TileGrid& grid, ClippedPolygon& out)
+	{
+		CGAL::Bbox_2 box = input.Bbox(polygon);
+
+		int c0 = (std::max)(0, int(std::floor((box.xmin() - grid.x) / grid.width)));
+		int c1 = (std::min)(grid.columns - 1, int(std::floor((box.xmax() - grid.x) / grid.width)));
+		int r0 = (std::max)(0, int(std::floor((box.ymin() - grid.y) / grid.height)));
+		int r1 = (std::min)(grid.rows - 1, int(std::floor((box.ymax() - grid.y) / grid.height)));
+
+		int first = input.ringOffsets[polygon];
+		int numRings = input.polygonRings[polygon];
+
+		//Built the first time a tile needs the exact intersection.
+		PolygonWithHoles pwh;
+		bool pwhBuilt = false;
+
+		for (int row = r0; row <= r1; row++)
+		{
+			for (int column = c0; column <= c1; column++)
+			{
+				CGAL::Bbox_2 tile = grid.Tile(column, row);
+				int tileIndex = row * grid.columns + column;
+
+				vector<vector<Point2f>> rings;
+				bool exact = false;
+
+				const Point2f* outer = input.RingPoints(first);
+				vector<Point2f> ring(outer, outer + input.ringSizes[first]);
+
+				if (!ClipRingToTile(ring, tile))
+					exact = true;
+				else if (ring.size() >= 3)
+					rings.push_back(ring);
+
+				for (int r = first + 1; r < first + numRings && rings.size() > 0; r++)
+				{
+					const Point2f* p = input.RingPoints(r);
+					int n = input.ringSizes[r];
+
+					HoleInTile hole = ClassifyHole(p, n, tile);
+
+					if (hole == HOLE_INSIDE)
+					{
+						rings.push_back(vector<Point2f>(p, p + n));
+					}
+					else if (hole == HOLE_CROSSES)
+					{
+						exact = true;
+						break;
+					}
+					else if (hole == HOLE_COVERS)
+					{
+						rings.clear();
+					}
+				}
+
+				if (exact)
+				{
+					if (!pwhBuilt)
+					{
+						pwh = input.ToPolygon<PolygonWithHoles>(polygon);
+						pwhBuilt = true;
+					}
+
+					Polygon square;
+					square.push_back(Point(tile.xmin(), tile.ymin()));
+					square.push_back(Point(tile.xmax(), tile.ymin()));
+					square.push_back(Point(tile.xmax(), tile.ymax()));
+					square.push_back(Point(tile.xmin(), tile.ymax()));
+
+					vector<PolygonWithHoles> pieces;
+					CGAL::intersection(pwh, square, back_inserter(pieces));
+
+					for (auto& piece : pieces)
+					{
+						out.pieces.AddPolygonWithHoles(piece);
+						out.tiles.push_back(tileIndex);
+					}
+				}
+				else if (rings.size() > 0)
+				{
+					out.pieces.ringOffsets.push_back(int(out.pieces.ringSizes.size()));
+					out.pieces.polygonRings.push_back(int(rings.size()));
+
+					for (auto& ring : rings)
+					{
+						out.pieces.pointOffsets.push_back(int(out.pieces.points.size()));
+						out.pieces.ringSizes.push_back(int(ring.size()));
+						out.pieces.points.insert(out.pieces.points.end(), ring.begin(), ring.end());
+					}
+
+					out.tiles.push_back(tileIndex);
+				}
+			}
+		}
+	}
+
+	void AppendPolygon(const PolygonBuffer2f& from, int polygon, PolygonBuffer2f& to)
+	{
+		int first = from.ringOffsets[polygon];
+
+		to.ringOffsets.push_back(int(to.ringSizes.size()));
+		to.polygonRings.push_back(from.polygonRings[polygon]);
+
+		for (int r = first; r < first + from.polygonRings[polygon]; r++)
+		{
+			const Point2f* p = from.RingPoints(r);
+
+			to.pointOffsets.push_back(int(to.points.size()));
+			to.ringSizes.push_back(from.ringSizes[r]);
+			to.points.insert(to.points.end(), p, p + from.ringSizes[r]);
+		}
+	}
+
+	//Cuts the polygons into the tiles of a grid of columns by rows tiles of the
+	//given size starting at the origin, in parallel. The pieces are grouped by
+	//tile, numbered row by row, with the input polygon each came from.
+	CGALWRAPPERAPI CGALResult CALLCON Boolean2_ClipToGrid2f(const Point2f* inPoints, const int* inRingSizes, const int* inPolygonRings, int numPolygons, Point2f origin, float tileWidth, float tileHeight, int columns, int rows, PolygonBufferDescriptor& descriptor)
+	{
+		try
+		{
+			gridTiles.Clear();
+			tileOffsets.clear();
+			tileSources.clear();
+			descriptor = gridTiles.Descriptor();
+
+			if (tileWidth <= 0 || tileHeight <= 0 || columns < 1 || rows < 1)
+				return CGAL_ERROR;
+
+			TileGrid grid = { origin.x, origin.y, tileWidth, tileHeight, columns, rows };
+
+			PolygonBuffer2f input;
+			input.Load(inPoints, inRingSizes, inPolygonRings, numPolygons);
+
+			vector<ClippedPolygon> clipped(input.NumPolygons());
+
+			Utility::ParallelFor(input.NumPolygons(), [&](int i)
+			{
+				ClipToTiles(input, i, grid, clipped[i]);
+			});
+
+			int numTiles = columns * rows;
+			tileOffsets.assign(numTiles + 1, 0);
+
+			for (auto& polygon : clipped)
+			{
+				for (int tile : polygon.tiles)
+					tileOffsets[tile + 1]++;
+			}
+
+			for (int i = 0; i < numTiles; i++)
+				tileOffsets[i + 1] += tileOffsets[i];
+
+			vector<pair<int, int>> order(tileOffsets[numTiles]);
+			vector<int> next(tileOffsets.begin(), tileOffsets.end() - 1);
+
+			for (int i = 0; i < int(clipped.size()); i++)
+			{
+				for (int j = 0; j < int(clipped[i].tiles.size()); j++)
+					order[next[clipped[i].tiles[j]]++] = make_pair(i, j);
+			}
+
+			for (auto& piece : order)
+			{
+				AppendPolygon(clipped[piece.first].pieces, piece.second, gridTiles);
+				tileSources.push_back(piece.first);
+			}
+
+			descriptor = gridTiles.Descriptor();
+			return CGAL_SUCCESS;
+		}
+		catch (...)
+		{
+			gridTiles.Clear();
+			tileOffsets.clear();
+			tileSources.clear();
+			descriptor = gridTiles.Descriptor();
+			return CGAL_ERROR;
+		}
+	}
+
+	//Copies out the tile pieces, where each tile's pieces start plus the total,
+	//and the input polygon of each piece.
+	CGALWRAPPERAPI void CALLCON Boolean2_GetGridTiles2f(Point2f* outPoints, int* outRingSizes, int* outPolygonRings, int* outTileOffsets, int* outSources)
+	{
+		gridTiles.CopyTo(outPoints, outRingSizes, outPolygonRings);
+
+		if (outTileOffsets != nullptr)
+			std::copy(tileOffsets.begin(), tileOffsets.end(), outTileOffsets);
+
+		if (outSources != nullptr)
+			std::copy(tileSources.begin(), tileSources.end(), outSources);
+	}
+
 }
\ No newline at end of file
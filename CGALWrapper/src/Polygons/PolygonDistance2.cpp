@@ -0,0 +1,327 @@
+
+#include "stdafx.h"
+#include "Polygons/PolygonDistance2.h"
+#include "Primatives/PolygonBuffer2.h"
+#include "Utility/ParallelFor.h"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+using namespace std;
+
+namespace PolygonDistance2
+{
+
+	struct Edge
+	{
+		double x0, y0, x1, y1;
+	};
+
+	struct Grid
+	{
+		double xmin, ymin, cellSize;
+		int width, height;
+
+		double X(int c) const { return xmin + (c + 0.5) * cellSize; }
+
+		double Y(int r) const { return ymin + (r + 0.5) * cellSize; }
+	};
+
+	//Cells within this many cells of an edge get their distance from an exact
+	//search over the edges rasterized into their row. The rest are filled by
+	//jump flooding the nearest edge ids outwards.
+	const int BAND_CELLS = 2;
+
+	double SegmentDistance2(const Edge& e, double px, double py)
+	{
+		double dx = e.x1 - e.x0, dy = e.y1 - e.y0;
+		double len2 = dx * dx + dy * dy;
+
+		double t = (len2 > 0) ? ((px - e.x0) * dx + (py - e.y0) * dy) / len2 : 0;
+		t = (std::max)(0.0, (std::min)(1.0, t));
+
+		double ex = e.x0 + t * dx - px, ey = e.y0 + t * dy - py;
+		return ex * ex + ey * ey;
+	}
+
+	int Clamp(int v, int lo, int hi)
+	{
+		return (std::max)(lo, (std::min)(hi, v));
+	}
+
+	void PackEdges(const PolygonBuffer2f& buffer, vector<Edge>& edges)
+	{
+		for (size_t ring = 0; ring < buffer.ringSizes.size(); ring++)
+		{
+			const Point2f* p = buffer.RingPoints(int(ring));
+			int size = buffer.ringSizes[ring];
+
+			for (int i = 0; i < size; i++)
+			{
+				const Point2f& a = p[i];
+				const Point2f& b = p[(i + 1) % size];
+				edges.push_back({ a.x, a.y, b.x, b.y });
+			}
+		}
+	}
+
+	//Column range of the cells in row r whose centers may lie within radius of the edge.
+	bool EdgeRowSpan(const Grid& grid, const Edge& e, double radius, int r, int& c0, int& c1)
+	{
+		double ylo = (std::min)(e.y0, e.y1), yhi = (std::max)(e.y0, e.y1);
+
+		double cy = grid.Y(r);
+		double a = (std::max)(ylo, cy - radius);
+		double b = (std::min)(yhi, cy + radius);
+		if (a > b) return false;
+
+		double xa, xb;
+		if (e.y1 == e.y0)
+		{
+			xa = e.x0;
+			xb = e.x1;
+		}
+		else
+		{
+			xa = e.x0 + (a - e.y0) * (e.x1 - e.x0) / (e.y1 - e.y0);
+			xb = e.x0 + (b - e.y0) * (e.x1 - e.x0) / (e.y1 - e.y0);
+		}
+
+		c0 = int(ceil(((std::min)(xa, xb) - radius - grid.xmin) / grid.cellSize - 0.5));
+		c1 = int(floor(((std::max)(xa, xb) + radius - grid.xmin) / grid.cellSize - 0.5));
+		c0 = (std::max)(c0, 0);
+		c1 = (std::min)(c1, grid.width - 1);
+
+		return c0 <= c1;
+	}
+
+	//Rows the edge passes within radius of. Edges off the side of the grid are
+	//still listed as they decide the winding of the cells in the row.
+	template <class FUNC>
+	void ForEachEdgeRow(const Grid& grid, const Edge& e, double radius, FUNC func)
+	{
+		double ylo = (std::min)(e.y0, e.y1), yhi = (std::max)(e.y0, e.y1);
+
+		int r0 = int(ceil((ylo - radius - grid.ymin) / grid.cellSize - 0.5));
+		int r1 = int(floor((yhi + radius - grid.ymin) / grid.cellSize - 0.5));
+		r0 = (std::max)(r0, 0);
+		r1 = (std::min)(r1, grid.height - 1);
+
+		for (int r = r0; r <= r1; r++)
+			func(r);
+	}
+
+	//Exact nearest edge for cells in the band and the nonzero winding sign of
+	//every cell, one row at a time from the edges bucketed into that row.
+	void BandPass(const Grid& grid, const vector<Edge>& edges, vector<int>& nearest, vector<signed char>& inside)
+	{
+		double radius = BAND_CELLS * grid.cellSize;
+
+		vector<int> rowStart(grid.height + 1, 0);
+		for (const Edge& e : edges)
+			ForEachEdgeRow(grid, e, radius, [&](int r) { rowStart[r + 1]++; });
+
+		for (int r = 0; r < grid.height; r++)
+			rowStart[r + 1] += rowStart[r];
+
+		vector<int> rowEdges(rowStart.back());
+		vector<int> fill(rowStart.begin(), rowStart.end() - 1);
+
+		for (int i = 0; i < int(edges.size()); i++)
+			ForEachEdgeRow(grid, edges[i], radius, [&](int r) { rowEdges[fill[r]++] = i; });
+
+		Utility::ParallelFor(grid.height, [&](int r)
+		{
+			double cy = grid.Y(r);
+			int* rowNearest = &nearest[r * grid.width];
+			vector<double> best(grid.width, radius * radius);
+			vector<pair<double, int>> crossings;
+
+			for (int i = rowStart[r]; i < rowStart[r + 1]; i++)
+			{
+				const Edge& e = edges[rowEdges[i]];
+
+				if ((e.y0 > cy) != (e.y1 > cy))
+				{
+					double x = e.x0 + (cy - e.y0) * (e.x1 - e.x0) / (e.y1 - e.y0);
+					crossings.push_back(make_pair(x, (e.y1 > e.y0) ? 1 : -1));
+				}
+
+				int c0, c1;
+				if (!EdgeRowSpan(grid, e, radius, r, c0, c1)) continue;
+
+				for (int c = c0; c <= c1; c++)
+				{
+					double d = SegmentDistance2(e, grid.X(c), cy);
+					if (d <= best[c])
+					{
+						best[c] = d;
+						rowNearest[c] = rowEdges[i];
+					}
+				}
+			}
+
+			sort(crossings.begin(), crossings.end());
+
+			size_t next = 0;
+			int winding = 0;
+			for (int c = 0; c < grid.width; c++)
+			{
+				double cx = grid.X(c);
+				while (next < crossings.size() && crossings[next].first < cx)
+					winding += crossings[next++].second;
+
+				inside[c + r * grid.width] = (winding != 0) ? 1 : 0;
+			}
+		});
+	}
+
+	//Jump flooding of nearest edge ids. Cells already holding an edge from the
+	//band pass are exact and are left alone.
+	void FloodPass(const Grid& grid, const vector<Edge>& edges, vector<int>& nearest)
+	{
+		int size = (std::max)(grid.width, grid.height);
+		int step = 1;
+		while (step < size) step *= 2;
+
+		vector<unsigned char> exact(nearest.size());
+		for (size_t i = 0; i < nearest.size(); i++)
+			exact[i] = nearest[i] != -1;
+
+		vector<int> next(nearest.size());
+
+		//The final extra pass with a step of one fixes most of the errors
+		//jump flooding makes at Voronoi boundaries.
+		for (step /= 2; step >= 1; step = (step > 1) ? step / 2 : 0)
+		{
+			for (int pass = 0; pass < ((step == 1) ? 2 : 1); pass++)
+			{
+				Utility::ParallelFor(grid.height, [&](int r)
+				{
+					double cy = grid.Y(r);
+
+					for (int c = 0; c < grid.width; c++)
+					{
+						int cell = c + r * grid.width;
+						int bestEdge = nearest[cell];
+
+						if (exact[cell])
+						{
+							next[cell] = bestEdge;
+							continue;
+						}
+
+						double cx = grid.X(c);
+						double best = (bestEdge != -1) ? SegmentDistance2(edges[bestEdge], cx, cy) : numeric_limits<double>::max();
+
+						for (int dy = -step; dy <= step; dy += step)
+						{
+							int y = r + dy;
+							if (y < 0 || y >= grid.height) continue;
+
+							for (int dx = -step; dx <= step; dx += step)
+							{
+								int x = c + dx;
+								if (x < 0 || x >= grid.width) continue;
+
+								int e = nearest[x + y * grid.width];
+								if (e == -1 || e == bestEdge) continue;
+
+								double d = SegmentDistance2(edges[e], cx, cy);
+								if (d < best)
+								{
+									best = d;
+									bestEdge = e;
+								}
+							}
+						}
+
+						next[cell] = bestEdge;
+					}
+				});
+
+				nearest.swap(next);
+			}
+		}
+	}
+
+	//Only needed when no cell lies within the band of an edge, leaving
+	//nothing to flood from.
+	void NearestPass(const Grid& grid, const vector<Edge>& edges, vector<int>& nearest)
+	{
+		Utility::ParallelFor(grid.height, [&](int r)
+		{
+			double cy = grid.Y(r);
+
+			for (int c = 0; c < grid.width; c++)
+			{
+				double cx = grid.X(c);
+				double best = numeric_limits<double>::max();
+				int cell = c + r * grid.width;
+
+				for (int e = 0; e < int(edges.size()); e++)
+				{
+					double d = SegmentDistance2(edges[e], cx, cy);
+					if (d < best)
+					{
+						best = d;
+						nearest[cell] = e;
+					}
+				}
+			}
+		});
+	}
+
+	CGALWRAPPERAPI CGALResult CALLCON Distance2_SignedDistanceField2f(const Point2f* inPoints, const int* inRingSizes, const int* inPolygonRings, int numPolygons,
+		float xmin, float ymin, float cellSize, int width, int height, float* outField)
+	{
+		try
+		{
+			if (width < 1 || height < 1 || cellSize <= 0) return CGAL_ERROR;
+
+			PolygonBuffer2f buffer;
+			buffer.Load(inPoints, inRingSizes, inPolygonRings, numPolygons);
+
+			vector<Edge> edges;
+			PackEdges(buffer, edges);
+
+			Grid grid = { xmin, ymin, cellSize, width, height };
+
+			if (edges.size() == 0)
+			{
+				fill(outField, outField + width * height, numeric_limits<float>::max());
+				return CGAL_SUCCESS;
+			}
+
+			vector<int> nearest(width * height, -1);
+			vector<signed char> inside(width * height, 0);
+
+			BandPass(grid, edges, nearest, inside);
+
+			if (find_if(nearest.begin(), nearest.end(), [](int e) { return e != -1; }) != nearest.end())
+				FloodPass(grid, edges, nearest);
+			else
+				NearestPass(grid, edges, nearest);
+
+			Utility::ParallelFor(height, [&](int r)
+			{
+				double cy = grid.Y(r);
+
+				for (int c = 0; c < width; c++)
+				{
+					int cell = c + r * width;
+					float d = float(sqrt(SegmentDistance2(edges[nearest[cell]], grid.X(c), cy)));
+					outField[cell] = inside[cell] ? -d : d;
+				}
+			});
+
+			return CGAL_SUCCESS;
+		}
+		catch (...)
+		{
+			return CGAL_ERROR;
+		}
+	}
+
+}
\ No newline at end of file
@@ -1,12 +1,18 @@
 
 #include "stdafx.h"
 #include "Polygons/PolygonIntersection2.h"
+#include "Utility/ParallelFor.h"
 
 #include <CGAL/Exact_predicates_inexact_constructions_kernel.h>
 #include <CGAL/Polygon_2.h>
 #include <CGAL/Polygon_with_holes_2.h>
 #include <CGAL/enum.h>
 
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <emmintrin.h>
+
 using namespace std;
 
 namespace PolygonIntersection2
@@ -17,12 +23,687 @@ namespace PolygonIntersection2
 	typedef CGAL::Polygon_2<K> Polygon;
 	typedef CGAL::Polygon_with_holes_2<K> PolygonWithHoles;
 
+	struct PolygonGrid
+	{
+		double xmin, ymin, xmax, ymax;
+		double cellWidth, cellHeight;
+		int width, height;
+
+		vector<int> cellStart;
+		vector<int> items;
+	};
+
+	//Edges of every ring of every polygon in structure of arrays form so the
+	//crossing test can run two edges per SSE2 instruction. Each polygon's range
+	//is padded to an even count with edges that never cross or come near a point.
+	struct PackedEdges
+	{
+		vector<double> x0, y0, x1, y1, length;
+		vector<int> polygon;
+		vector<int> begin, end;
+		vector<double> tolerance;
+	};
+
+	//Grid over the edges of a single large polygon. Each cell lists the edges
+	//passing through it and whether its center is inside the polygon, so a
+	//query only has to count crossings between the point and its cell center.
+	struct EdgeGrid
+	{
+		double xmin, ymin;
+		double cellWidth, cellHeight;
+		int width, height;
+
+		vector<int> cellStart;
+		vector<int> items;
+		vector<signed char> centerInside;
+	};
+
+	//Bounding volume hierarchy over the packed edges for ray queries.
+	//Leaves have left = -1 and own the range [begin, end) of bvhEdges.
+	struct BvhNode
+	{
+		double xmin, ymin, xmax, ymax;
+		int left, right;
+		int begin, end;
+	};
+
+	const int MAX_GRID_SIZE = 256;
+	const int MAX_EDGE_GRID_SIZE = 2048;
+	const int DEFAULT_EDGE_GRID_THRESHOLD = 256;
+	const double EDGE_GRID_CELLS_PER_EDGE = 2.0;
+	const int BATCH_CHUNK_SIZE = 1024;
+	const int BVH_LEAF_SIZE = 4;
+	const int BVH_STACK_SIZE = 64;
+	const double PADDING_Y = 1e300;
+	const double BOUNDARY_TOLERANCE = 1e-7;
+
 	vector<PolygonWithHoles> polygons;
+	vector<CGAL::Bbox_2> boxes;
+	PolygonGrid grid = { 0, 0, 0, 0, 1, 1, 0, 0, {}, {} };
+	PackedEdges packed;
+	vector<EdgeGrid> edgeGrids;
+	vector<BvhNode> bvh;
+	vector<int> bvhEdges;
+	int edgeGridThreshold = DEFAULT_EDGE_GRID_THRESHOLD;
+	bool indexDirty = true;
+	bool bvhDirty = true;
+
+	int GridCell(double v, double origin, double cellSize, int size)
+	{
+		int i = int(floor((v - origin) / cellSize));
+		return (std::max)(0, (std::min)(size - 1, i));
+	}
+
+	void BuildGrid()
+	{
+		grid.width = grid.height = 0;
+		grid.cellStart.clear();
+		grid.items.clear();
+
+		int count = int(boxes.size());
+		if (count == 0) return;
+
+		grid.xmin = boxes[0].xmin();
+		grid.ymin = boxes[0].ymin();
+		grid.xmax = boxes[0].xmax();
+		grid.ymax = boxes[0].ymax();
+
+		for (const auto& box : boxes)
+		{
+			grid.xmin = (std::min)(grid.xmin, box.xmin());
+			grid.ymin = (std::min)(grid.ymin, box.ymin());
+			grid.xmax = (std::max)(grid.xmax, box.xmax());
+			grid.ymax = (std::max)(grid.ymax, box.ymax());
+		}
+
+		int size = int(ceil(sqrt(double(count))));
+		size = (std::max)(1, (std::min)(MAX_GRID_SIZE, size));
+
+		grid.width = grid.height = size;
+		grid.cellWidth = (grid.xmax > grid.xmin) ? (grid.xmax - grid.xmin) / size : 1.0;
+		grid.cellHeight = (grid.ymax > grid.ymin) ? (grid.ymax - grid.ymin) / size : 1.0;
+
+		grid.cellStart.assign(size * size + 1, 0);
+
+		for (int pass = 0; pass < 2; pass++)
+		{
+			vector<int> fill;
+			if (pass == 1)
+			{
+				for (int i = 0; i < size * size; i++)
+					grid.cellStart[i + 1] += grid.cellStart[i];
+
+				grid.items.resize(grid.cellStart.back());
+				fill.assign(grid.cellStart.begin(), grid.cellStart.end() - 1);
+			}
+
+			for (int i = 0; i < count; i++)
+			{
+				const CGAL::Bbox_2& box = boxes[i];
+				int x0 = GridCell(box.xmin(), grid.xmin, grid.cellWidth, size);
+				int x1 = GridCell(box.xmax(), grid.xmin, grid.cellWidth, size);
+				int y0 = GridCell(box.ymin(), grid.ymin, grid.cellHeight, size);
+				int y1 = GridCell(box.ymax(), grid.ymin, grid.cellHeight, size);
+
+				for (int y = y0; y <= y1; y++)
+				{
+					for (int x = x0; x <= x1; x++)
+					{
+						int cell = x + y * size;
+						if (pass == 0)
+							grid.cellStart[cell + 1]++;
+						else
+							grid.items[fill[cell]++] = i;
+					}
+				}
+			}
+		}
+	}
+
+	void PackEdge(double x0, double y0, double x1, double y1)
+	{
+		packed.x0.push_back(x0);
+		packed.y0.push_back(y0);
+		packed.x1.push_back(x1);
+		packed.y1.push_back(y1);
+		packed.length.push_back(sqrt((x1 - x0) * (x1 - x0) + (y1 - y0) * (y1 - y0)));
+	}
+
+	void PackRing(const Polygon& ring)
+	{
+		int size = int(ring.size());
+		for (int i = 0; i < size; i++)
+		{
+			const Point& a = ring[i];
+			const Point& b = ring[(i + 1) % size];
+			PackEdge(a.x(), a.y(), b.x(), b.y());
+		}
+	}
+
+	void PackEdges()
+	{
+		packed = PackedEdges();
+
+		for (size_t i = 0; i < polygons.size(); i++)
+		{
+			const PolygonWithHoles& polygon = polygons[i];
+			int begin = int(packed.x0.size());
+
+			PackRing(polygon.outer_boundary());
+			for (auto hole = polygon.holes_begin(); hole != polygon.holes_end(); ++hole)
+				PackRing(*hole);
+
+			if ((packed.x0.size() - begin) % 2 != 0)
+				PackEdge(0, PADDING_Y, 0, PADDING_Y);
+
+			packed.polygon.resize(packed.x0.size(), int(i));
+
+			const CGAL::Bbox_2& box = boxes[i];
+			double extent = (std::max)(box.xmax() - box.xmin(), box.ymax() - box.ymin());
+
+			packed.begin.push_back(begin);
+			packed.end.push_back(int(packed.x0.size()));
+			packed.tolerance.push_back(BOUNDARY_TOLERANCE * (std::max)(extent, 1.0));
+		}
+	}
+
+	template <class FUNC>
+	void ForEachEdgeCell(const EdgeGrid& eg, int edge, double pad, FUNC func)
+	{
+		double x0 = packed.x0[edge], y0 = packed.y0[edge];
+		double x1 = packed.x1[edge], y1 = packed.y1[edge];
+
+		double ylo = (std::min)(y0, y1), yhi = (std::max)(y0, y1);
+		int r0 = GridCell(ylo - pad, eg.ymin, eg.cellHeight, eg.height);
+		int r1 = GridCell(yhi + pad, eg.ymin, eg.cellHeight, eg.height);
+
+		for (int r = r0; r <= r1; r++)
+		{
+			double a = (std::max)(ylo, eg.ymin + r * eg.cellHeight - pad);
+			double b = (std::min)(yhi, eg.ymin + (r + 1) * eg.cellHeight + pad);
+			a = (std::min)(a, yhi);
+			b = (std::max)(b, ylo);
+
+			double xa, xb;
+			if (y1 == y0)
+			{
+				xa = x0;
+				xb = x1;
+			}
+			else
+			{
+				xa = x0 + (a - y0) * (x1 - x0) / (y1 - y0);
+				xb = x0 + (b - y0) * (x1 - x0) / (y1 - y0);
+			}
+
+			int c0 = GridCell((std::min)(xa, xb) - pad, eg.xmin, eg.cellWidth, eg.width);
+			int c1 = GridCell((std::max)(xa, xb) + pad, eg.xmin, eg.cellWidth, eg.width);
+
+			for (int c = c0; c <= c1; c++)
+				func(c + r * eg.width);
+		}
+	}
+
+	double SegmentDistance(int edge, double px, double py)
+	{
+		double x0 = packed.x0[edge], y0 = packed.y0[edge];
+		double dx = packed.x1[edge] - x0, dy = packed.y1[edge] - y0;
+		double len2 = dx * dx + dy * dy;
+
+		double t = (len2 > 0) ? ((px - x0) * dx + (py - y0) * dy) / len2 : 0;
+		t = (std::max)(0.0, (std::min)(1.0, t));
+
+		double ex = x0 + t * dx - px, ey = y0 + t * dy - py;
+		return sqrt(ex * ex + ey * ey);
+	}
+
+	void BuildEdgeGrid(int index, EdgeGrid& eg)
+	{
+		int begin = packed.begin[index];
+		int end = packed.end[index];
+		double tol = packed.tolerance[index];
+		const CGAL::Bbox_2& box = boxes[index];
+
+		int size = int(ceil(sqrt(EDGE_GRID_CELLS_PER_EDGE * (end - begin))));
+		size = (std::max)(1, (std::min)(MAX_EDGE_GRID_SIZE, size));
+
+		eg.width = eg.height = size;
+		eg.xmin = box.xmin();
+		eg.ymin = box.ymin();
+		eg.cellWidth = (box.xmax() > box.xmin()) ? (box.xmax() - box.xmin()) / size : 1.0;
+		eg.cellHeight = (box.ymax() > box.ymin()) ? (box.ymax() - box.ymin()) / size : 1.0;
+
+		int numCells = size * size;
+		eg.cellStart.assign(numCells + 1, 0);
+
+		for (int e = begin; e < end; e++)
+		{
+			if (packed.y0[e] == PADDING_Y) continue;
+			ForEachEdgeCell(eg, e, tol, [&](int cell) { eg.cellStart[cell + 1]++; });
+		}
+
+		for (int i = 0; i < numCells; i++)
+			eg.cellStart[i + 1] += eg.cellStart[i];
+
+		eg.items.resize(eg.cellStart.back());
+		vector<int> fill(eg.cellStart.begin(), eg.cellStart.end() - 1);
+
+		for (int e = begin; e < end; e++)
+		{
+			if (packed.y0[e] == PADDING_Y) continue;
+			ForEachEdgeCell(eg, e, tol, [&](int cell) { eg.items[fill[cell]++] = e; });
+		}
+
+		//Parity of each cell center from a horizontal ray to the left,
+		//using the edges that cross the row's center line.
+		eg.centerInside.assign(numCells, 0);
+		vector<int> stamp(end - begin, -1);
+		vector<double> crossings;
+
+		for (int r = 0; r < size; r++)
+		{
+			double cy = eg.ymin + (r + 0.5) * eg.cellHeight;
+			crossings.clear();
+
+			for (int c = 0; c < size; c++)
+			{
+				int cell = c + r * size;
+				for (int i = eg.cellStart[cell]; i < eg.cellStart[cell + 1]; i++)
+				{
+					int e = eg.items[i];
+					if (stamp[e - begin] == r) continue;
+					stamp[e - begin] = r;
+
+					double y0 = packed.y0[e], y1 = packed.y1[e];
+					if ((y0 > cy) == (y1 > cy)) continue;
+
+					double x0 = packed.x0[e], x1 = packed.x1[e];
+					crossings.push_back(x0 + (cy - y0) * (x1 - x0) / (y1 - y0));
+				}
+			}
+
+			sort(crossings.begin(), crossings.end());
+
+			size_t next = 0;
+			for (int c = 0; c < size; c++)
+			{
+				double cx = eg.xmin + (c + 0.5) * eg.cellWidth;
+				while (next < crossings.size() && crossings[next] < cx) next++;
+
+				int cell = c + r * size;
+				signed char inside = (signed char)(next & 1);
+
+				for (int i = eg.cellStart[cell]; i < eg.cellStart[cell + 1]; i++)
+				{
+					if (SegmentDistance(eg.items[i], cx, cy) <= tol)
+					{
+						inside = -1;
+						break;
+					}
+				}
+
+				eg.centerInside[cell] = inside;
+			}
+		}
+	}
+
+	void BuildEdgeGrids()
+	{
+		edgeGrids.assign(polygons.size(), EdgeGrid());
+
+		for (size_t i = 0; i < polygons.size(); i++)
+		{
+			edgeGrids[i].width = edgeGrids[i].height = 0;
+
+			if (packed.end[i] - packed.begin[i] >= edgeGridThreshold)
+				BuildEdgeGrid(int(i), edgeGrids[i]);
+		}
+	}
+
+	void BuildIndex()
+	{
+		BuildGrid();
+		PackEdges();
+		BuildEdgeGrids();
+		indexDirty = false;
+		bvhDirty = true;
+	}
+
+	int BuildBvhNode(int begin, int end)
+	{
+		BvhNode node;
+		node.xmin = node.ymin = numeric_limits<double>::max();
+		node.xmax = node.ymax = -numeric_limits<double>::max();
+		node.left = node.right = -1;
+		node.begin = begin;
+		node.end = end;
+
+		for (int i = begin; i < end; i++)
+		{
+			int e = bvhEdges[i];
+			node.xmin = (std::min)(node.xmin, (std::min)(packed.x0[e], packed.x1[e]));
+			node.ymin = (std::min)(node.ymin, (std::min)(packed.y0[e], packed.y1[e]));
+			node.xmax = (std::max)(node.xmax, (std::max)(packed.x0[e], packed.x1[e]));
+			node.ymax = (std::max)(node.ymax, (std::max)(packed.y0[e], packed.y1[e]));
+		}
+
+		int index = int(bvh.size());
+		bvh.push_back(node);
+
+		if (end - begin <= BVH_LEAF_SIZE) return index;
+
+		//Median split of the edge midpoints along the longer axis.
+		bool splitX = (node.xmax - node.xmin) >= (node.ymax - node.ymin);
+		int mid = begin + (end - begin) / 2;
+
+		nth_element(bvhEdges.begin() + begin, bvhEdges.begin() + mid, bvhEdges.begin() + end, [&](int a, int b)
+		{
+			if (splitX)
+				return packed.x0[a] + packed.x1[a] < packed.x0[b] + packed.x1[b];
+			else
+				return packed.y0[a] + packed.y1[a] < packed.y0[b] + packed.y1[b];
+		});
+
+		int left = BuildBvhNode(begin, mid);
+		int right = BuildBvhNode(mid, end);
+
+		bvh[index].left = left;
+		bvh[index].right = right;
+
+		return index;
+	}
+
+	void BuildBvh()
+	{
+		bvh.clear();
+		bvhEdges.clear();
+
+		for (int e = 0; e < int(packed.x0.size()); e++)
+		{
+			if (packed.y0[e] != PADDING_Y)
+				bvhEdges.push_back(e);
+		}
+
+		if (bvhEdges.size() > 0)
+			BuildBvhNode(0, int(bvhEdges.size()));
+
+		bvhDirty = false;
+	}
+
+	//Parametric range of the ray o + t * d inside the box, clipped to [0, tmax].
+	bool RayBox(const BvhNode& node, double ox, double oy, double dx, double dy, double tmax, double& tenter)
+	{
+		double t0 = 0, t1 = tmax;
+
+		if (dx == 0)
+		{
+			if (ox < node.xmin || ox > node.xmax) return false;
+		}
+		else
+		{
+			double a = (node.xmin - ox) / dx, b = (node.xmax - ox) / dx;
+			t0 = (std::max)(t0, (std::min)(a, b));
+			t1 = (std::min)(t1, (std::max)(a, b));
+		}
+
+		if (dy == 0)
+		{
+			if (oy < node.ymin || oy > node.ymax) return false;
+		}
+		else
+		{
+			double a = (node.ymin - oy) / dy, b = (node.ymax - oy) / dy;
+			t0 = (std::max)(t0, (std::min)(a, b));
+			t1 = (std::min)(t1, (std::max)(a, b));
+		}
+
+		tenter = t0;
+		return t0 <= t1;
+	}
+
+	//Parameter along the ray where it first touches the edge, or -1 if it misses.
+	//Collinear overlapping edges are hit at their nearest point ahead of the origin.
+	double RayEdge(int e, double ox, double oy, double dx, double dy)
+	{
+		double ax = packed.x0[e] - ox, ay = packed.y0[e] - oy;
+		double bx = packed.x1[e] - ox, by = packed.y1[e] - oy;
+		double ex = bx - ax, ey = by - ay;
+
+		double denom = dx * ey - dy * ex;
+		double cross = ax * dy - ay * dx;
+
+		if (denom == 0)
+		{
+			if (cross != 0) return -1;
+
+			double ta = ax * dx + ay * dy;
+			double tb = bx * dx + by * dy;
+			double len2 = dx * dx + dy * dy;
+
+			if (ta < 0 && tb < 0) return -1;
+			if ((ta < 0) != (tb < 0)) return 0;
+			return (std::min)(ta, tb) / len2;
+		}
+
+		double t = (ax * ey - ay * ex) / denom;
+		double s = cross / denom;
+
+		if (t < 0 || s < 0 || s > 1) return -1;
+		return t;
+	}
+
+	//Closest edge hit along o + t * d for t in [0, tmax].
+	RayHit CastRay(double ox, double oy, double dx, double dy, double tmax)
+	{
+		RayHit hit = { -1.0f, -1, -1 };
+		if (bvh.size() == 0) return hit;
+
+		double best = tmax;
+		int bestEdge = -1;
+
+		int stack[BVH_STACK_SIZE];
+		int top = 0;
+		double tenter;
+
+		if (RayBox(bvh[0], ox, oy, dx, dy, best, tenter))
+			stack[top++] = 0;
+
+		while (top > 0)
+		{
+			const BvhNode& node = bvh[stack[--top]];
+			if (!RayBox(node, ox, oy, dx, dy, best, tenter)) continue;
+
+			if (node.left == -1)
+			{
+				for (int i = node.begin; i < node.end; i++)
+				{
+					int e = bvhEdges[i];
+					double t = RayEdge(e, ox, oy, dx, dy);
+
+					if (t >= 0 && (t < best || (t == best && bestEdge == -1)))
+					{
+						best = t;
+						bestEdge = e;
+					}
+				}
+
+				continue;
+			}
+
+			//Push the farther child first so the nearer one is visited next.
+			double tl, tr;
+			bool hitLeft = RayBox(bvh[node.left], ox, oy, dx, dy, best, tl);
+			bool hitRight = RayBox(bvh[node.right], ox, oy, dx, dy, best, tr);
+
+			if (hitLeft && hitRight)
+			{
+				stack[top++] = (tl <= tr) ? node.right : node.left;
+				stack[top++] = (tl <= tr) ? node.left : node.right;
+			}
+			else if (hitLeft)
+				stack[top++] = node.left;
+			else if (hitRight)
+				stack[top++] = node.right;
+		}
+
+		if (bestEdge == -1) return hit;
+
+		int polygon = packed.polygon[bestEdge];
+		hit.distance = float(best * sqrt(dx * dx + dy * dy));
+		hit.polygon = polygon;
+		hit.edge = bestEdge - packed.begin[polygon];
+
+		return hit;
+	}
+
+	//Counts crossings between the point and its cell center, which has a known
+	//parity. Returns -1 if any edge comes within tolerance of being degenerate.
+	int EdgeGridTest(int index, double px, double py)
+	{
+		const EdgeGrid& eg = edgeGrids[index];
+		double tol = packed.tolerance[index];
+
+		int c = GridCell(px, eg.xmin, eg.cellWidth, eg.width);
+		int r = GridCell(py, eg.ymin, eg.cellHeight, eg.height);
+		int cell = c + r * eg.width;
+
+		int inside = eg.centerInside[cell];
+		if (inside == -1) return -1;
+
+		double cx = eg.xmin + (c + 0.5) * eg.cellWidth;
+		double cy = eg.ymin + (r + 0.5) * eg.cellHeight;
+		double dx = px - cx, dy = py - cy;
+		double len = sqrt(dx * dx + dy * dy);
+
+		for (int i = eg.cellStart[cell]; i < eg.cellStart[cell + 1]; i++)
+		{
+			int e = eg.items[i];
+			double x0 = packed.x0[e], y0 = packed.y0[e];
+			double x1 = packed.x1[e], y1 = packed.y1[e];
+			double elen = packed.length[e];
+
+			double o1 = dx * (y0 - cy) - dy * (x0 - cx);
+			double o2 = dx * (y1 - cy) - dy * (x1 - cx);
+			double o3 = (x1 - x0) * (cy - y0) - (y1 - y0) * (cx - x0);
+			double o4 = (x1 - x0) * (py - y0) - (y1 - y0) * (px - x0);
+
+			bool n1 = fabs(o1) <= tol * len, n2 = fabs(o2) <= tol * len;
+			bool n3 = fabs(o3) <= tol * elen, n4 = fabs(o4) <= tol * elen;
+
+			bool straddle12 = n1 || n2 || ((o1 > 0) != (o2 > 0));
+			bool straddle34 = n3 || n4 || ((o3 > 0) != (o4 > 0));
+			if (!straddle12 || !straddle34) continue;
+
+			if (n1 || n2 || n3 || n4) return -1;
+
+			inside ^= 1;
+		}
+
+		return inside;
+	}
+
+	//Even-odd crossing count over all rings of the polygon.
+	//Returns 1 if inside, 0 if outside and -1 if the point lies within the
+	//polygon's tolerance of an edge and needs the exact predicate.
+	int CrossingTest(int index, double px, double py)
+	{
+		const __m128d zero = _mm_setzero_pd();
+		const __m128d sign = _mm_set1_pd(-0.0);
+		const __m128d vx = _mm_set1_pd(px);
+		const __m128d vy = _mm_set1_pd(py);
+		const __m128d eps = _mm_set1_pd(packed.tolerance[index]);
+
+		int crossings = 0;
+
+		for (int i = packed.begin[index]; i < packed.end[index]; i += 2)
+		{
+			__m128d x0 = _mm_loadu_pd(&packed.x0[i]);
+			__m128d y0 = _mm_loadu_pd(&packed.y0[i]);
+			__m128d x1 = _mm_loadu_pd(&packed.x1[i]);
+			__m128d y1 = _mm_loadu_pd(&packed.y1[i]);
+			__m128d len = _mm_loadu_pd(&packed.length[i]);
+
+			__m128d above0 = _mm_cmpgt_pd(y0, vy);
+			__m128d above1 = _mm_cmpgt_pd(y1, vy);
+			__m128d straddle = _mm_xor_pd(above0, above1);
+
+			__m128d d = _mm_sub_pd(
+				_mm_mul_pd(_mm_sub_pd(x1, x0), _mm_sub_pd(vy, y0)),
+				_mm_mul_pd(_mm_sub_pd(vx, x0), _mm_sub_pd(y1, y0)));
+
+			__m128d left = _mm_cmpgt_pd(d, zero);
+			__m128d cross = _mm_andnot_pd(_mm_xor_pd(left, above1), straddle);
+
+			int mask = _mm_movemask_pd(cross);
+			crossings += (mask & 1) + (mask >> 1);
+
+			__m128d nearLine = _mm_cmple_pd(_mm_andnot_pd(sign, d), _mm_mul_pd(eps, len));
+			__m128d nearX = _mm_and_pd(
+				_mm_cmpge_pd(vx, _mm_sub_pd(_mm_min_pd(x0, x1), eps)),
+				_mm_cmple_pd(vx, _mm_add_pd(_mm_max_pd(x0, x1), eps)));
+			__m128d nearY = _mm_and_pd(
+				_mm_cmpge_pd(vy, _mm_sub_pd(_mm_min_pd(y0, y1), eps)),
+				_mm_cmple_pd(vy, _mm_add_pd(_mm_max_pd(y0, y1), eps)));
+
+			if (_mm_movemask_pd(_mm_and_pd(nearLine, _mm_and_pd(nearX, nearY))) != 0)
+				return -1;
+		}
+
+		return crossings & 1;
+	}
+
+	bool Contains(const PolygonWithHoles& polygon, const Point& p)
+	{
+		if (polygon.outer_boundary().bounded_side(p) != CGAL::ON_BOUNDED_SIDE)
+			return false;
+
+		for (auto hole = polygon.holes_begin(); hole != polygon.holes_end(); ++hole)
+		{
+			if (hole->bounded_side(p) != CGAL::ON_UNBOUNDED_SIDE)
+				return false;
+		}
+
+		return true;
+	}
+
+	bool InBox(const CGAL::Bbox_2& box, double x, double y)
+	{
+		return x >= box.xmin() && x <= box.xmax() && y >= box.ymin() && y <= box.ymax();
+	}
+
+	int FindContaining(double x, double y)
+	{
+		if (grid.width == 0) return -1;
+
+		if (x < grid.xmin || x > grid.xmax || y < grid.ymin || y > grid.ymax)
+			return -1;
+
+		int cx = GridCell(x, grid.xmin, grid.cellWidth, grid.width);
+		int cy = GridCell(y, grid.ymin, grid.cellHeight, grid.height);
+		int cell = cx + cy * grid.width;
+
+		for (int i = grid.cellStart[cell]; i < grid.cellStart[cell + 1]; i++)
+		{
+			int index = grid.items[i];
+			if (!InBox(boxes[index], x, y)) continue;
+
+			int inside = (edgeGrids[index].width > 0) ? EdgeGridTest(index, x, y) : CrossingTest(index, x, y);
+
+			if (inside == -1)
+				inside = Contains(polygons[index], Point(x, y)) ? 1 : 0;
+
+			if (inside == 1) return index;
+		}
+
+		return -1;
+	}
 
 	CGALWRAPPERAPI void CALLCON Intersection2_PushPolygon2f(const Point2f* inPoints, int inSize)
 	{
 		vector<Point> points = ToPointArray2<Point, Point2f>(inPoints, inSize);
 		polygons.push_back(PolygonWithHoles(Polygon(points.begin(), points.end())));
+		boxes.push_back(polygons.back().outer_boundary().bbox());
+		indexDirty = true;
 	}
 
 	CGALWRAPPERAPI void CALLCON Intersection2_AddHole2f(const Point2f* inPoints, int inSize)
@@ -34,6 +715,7 @@ namespace PolygonIntersection2
 		Polygon hole = Polygon(points.begin(), points.end());
 
 		polygons.back().add_hole(hole);
+		indexDirty = true;
 	}
 
 	CGALWRAPPERAPI void CALLCON Intersection2_PopPolygon()
@@ -42,38 +724,169 @@ namespace PolygonIntersection2
 		if (size == 0) return;
 
 		polygons.pop_back();
+		boxes.pop_back();
+		indexDirty = true;
 	}
 
 	CGALWRAPPERAPI void CALLCON Intersection2_PopAll()
 	{
 		polygons.clear();
+		boxes.clear();
+		edgeGrids.clear();
+		bvh.clear();
+		bvhEdges.clear();
+		indexDirty = true;
+	}
+
+	CGALWRAPPERAPI void CALLCON Intersection2_SetEdgeGridThreshold(int numEdges)
+	{
+		if (numEdges < 0) numEdges = DEFAULT_EDGE_GRID_THRESHOLD;
+		if (edgeGridThreshold == numEdges) return;
+
+		edgeGridThreshold = numEdges;
+		indexDirty = true;
 	}
 
 	CGALWRAPPERAPI BOOL CALLCON Intersection2_ContainsPoint2f(Point2f point)
 	{
+		if (indexDirty) BuildIndex();
 
-		Point p(point.x, point.y);
+		return FindContaining(point.x, point.y) != -1;
+	}
 
-		for each (auto polygon in polygons)
+	CGALWRAPPERAPI CGALResult CALLCON Intersection2_BatchContainsPoints2f(const Point2f* inPoints, int numPoints, int* outIndices)
+	{
+		try
 		{
-			if (polygon.outer_boundary().bounded_side(p) == CGAL::ON_BOUNDED_SIDE)
+			if (indexDirty) BuildIndex();
+
+			int chunks = (numPoints + BATCH_CHUNK_SIZE - 1) / BATCH_CHUNK_SIZE;
+
+			Utility::ParallelFor(chunks, [&](int chunk)
 			{
-				bool contains = true;
+				int begin = chunk * BATCH_CHUNK_SIZE;
+				int end = (std::min)(numPoints, begin + BATCH_CHUNK_SIZE);
 
-				for(auto hole = polygon.holes_begin(); hole != polygon.holes_end(); ++hole)
+				for (int i = begin; i < end; i++)
+					outIndices[i] = FindContaining(inPoints[i].x, inPoints[i].y);
+			});
+
+			return CGAL_SUCCESS;
+		}
+		catch (...)
+		{
+			return CGAL_ERROR;
+		}
+	}
+
+	CGALWRAPPERAPI CGALResult CALLCON Intersection2_BatchContainsPointsMask2f(const Point2f* inPoints, int numPoints, unsigned char* outMask)
+	{
+		try
+		{
+			if (indexDirty) BuildIndex();
+
+			int chunks = (numPoints + BATCH_CHUNK_SIZE - 1) / BATCH_CHUNK_SIZE;
+
+			Utility::ParallelFor(chunks, [&](int chunk)
+			{
+				int begin = chunk * BATCH_CHUNK_SIZE;
+				int end = (std::min)(numPoints, begin + BATCH_CHUNK_SIZE);
+
+				for (int i = begin; i < end; i += 8)
 				{
-					if (hole->bounded_side(p) != CGAL::ON_UNBOUNDED_SIDE)
+					unsigned char bits = 0;
+					for (int j = 0; j < 8 && i + j < end; j++)
 					{
-						contains = false;
-						break;
+						if (FindContaining(inPoints[i + j].x, inPoints[i + j].y) != -1)
+							bits |= (unsigned char)(1 << j);
 					}
+
+					outMask[i / 8] = bits;
 				}
+			});
 
-				if (contains) return true;
-			}
+			return CGAL_SUCCESS;
+		}
+		catch (...)
+		{
+			return CGAL_ERROR;
+		}
+	}
+
+	//Direction need not be normalized. Distances are measured in world units.
+	CGALWRAPPERAPI CGALResult CALLCON Intersection2_BatchRaycast2f(const Point2f* inOrigins, const Point2f* inDirections, int numRays, float maxDistance, RayHit* outHits)
+	{
+		try
+		{
+			if (indexDirty) BuildIndex();
+			if (bvhDirty) BuildBvh();
+
+			int chunks = (numRays + BATCH_CHUNK_SIZE - 1) / BATCH_CHUNK_SIZE;
+
+			Utility::ParallelFor(chunks, [&](int chunk)
+			{
+				int begin = chunk * BATCH_CHUNK_SIZE;
+				int end = (std::min)(numRays, begin + BATCH_CHUNK_SIZE);
+
+				for (int i = begin; i < end; i++)
+				{
+					double dx = inDirections[i].x, dy = inDirections[i].y;
+					double len = sqrt(dx * dx + dy * dy);
+
+					if (len == 0)
+					{
+						outHits[i] = { -1.0f, -1, -1 };
+						continue;
+					}
+
+					outHits[i] = CastRay(inOrigins[i].x, inOrigins[i].y, dx / len, dy / len, maxDistance);
+				}
+			});
+
+			return CGAL_SUCCESS;
 		}
+		catch (...)
+		{
+			return CGAL_ERROR;
+		}
+	}
+
+	//A segment has line of sight when its hit has no polygon.
+	CGALWRAPPERAPI CGALResult CALLCON Intersection2_BatchSegmentHits2f(const Point2f* inStarts, const Point2f* inEnds, int numSegments, RayHit* outHits)
+	{
+		try
+		{
+			if (indexDirty) BuildIndex();
+			if (bvhDirty) BuildBvh();
+
+			int chunks = (numSegments + BATCH_CHUNK_SIZE - 1) / BATCH_CHUNK_SIZE;
 
-		return false;
+			Utility::ParallelFor(chunks, [&](int chunk)
+			{
+				int begin = chunk * BATCH_CHUNK_SIZE;
+				int end = (std::min)(numSegments, begin + BATCH_CHUNK_SIZE);
+
+				for (int i = begin; i < end; i++)
+				{
+					double dx = double(inEnds[i].x) - inStarts[i].x;
+					double dy = double(inEnds[i].y) - inStarts[i].y;
+
+					if (dx == 0 && dy == 0)
+					{
+						outHits[i] = { -1.0f, -1, -1 };
+						continue;
+					}
+
+					outHits[i] = CastRay(inStarts[i].x, inStarts[i].y, dx, dy, 1.0);
+				}
+			});
+
+			return CGAL_SUCCESS;
+		}
+		catch (...)
+		{
+			return CGAL_ERROR;
+		}
 	}
 
 }
\ No newline at end of file
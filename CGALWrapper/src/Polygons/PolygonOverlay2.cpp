@@ -0,0 +1,257 @@
+
+#include "stdafx.h"
+#include "Polygons/PolygonOverlay2.h"
+#include "Primatives/PolygonBuffer2.h"
+
+#include <CGAL/Exact_predicates_exact_constructions_kernel.h>
+#include <CGAL/Arr_segment_traits_2.h>
+#include <CGAL/Arr_consolidated_curve_data_traits_2.h>
+#include <CGAL/Arr_extended_dcel.h>
+#include <CGAL/Arrangement_2.h>
+
+#include <queue>
+
+using namespace std;
+
+namespace PolygonOverlay2
+{
+
+	//The polygon each layer has over a face, or -1 if none.
+	struct FaceLabel
+	{
+		int a = -1;
+		int b = -1;
+		bool visited = false;
+	};
+
+	typedef CGAL::Exact_predicates_exact_constructions_kernel Kernel;
+	typedef Kernel::Point_2 Point;
+	typedef Kernel::Segment_2 Segment;
+	typedef CGAL::Arr_segment_traits_2<Kernel> SegmentTraits;
+	typedef CGAL::Arr_consolidated_curve_data_traits_2<SegmentTraits, int> Traits;
+	typedef Traits::Curve_2 Curve;
+	typedef CGAL::Arr_face_extended_dcel<Traits, FaceLabel> Dcel;
+	typedef CGAL::Arrangement_2<Traits, Dcel> Arrangement;
+
+	PolygonBuffer2f layerA, layerB;
+	PolygonBuffer2f faces;
+	vector<PolygonPair> sources;
+
+	//Each edge carries the polygon, layer and whether it ran left to right as
+	//given, so the side the polygon's interior is on can be recovered from the
+	//split and merged edges of the arrangement.
+	int EncodeEdge(int polygon, int layer, bool leftToRight)
+	{
+		return ((polygon * 2) + layer) * 2 + (leftToRight ? 0 : 1);
+	}
+
+	void AddEdges(const PolygonBuffer2f& layer, int layerIndex, vector<Curve>& curves)
+	{
+		for (int i = 0; i < layer.NumPolygons(); i++)
+		{
+			int first = layer.ringOffsets[i];
+
+			for (int r = first; r < first + layer.polygonRings[i]; r++)
+			{
+				const Point2f* p = layer.RingPoints(r);
+				int n = layer.ringSizes[r];
+
+				for (int j = 0; j < n; j++)
+				{
+					Point a(p[j].x, p[j].y);
+					Point b(p[(j + 1) % n].x, p[(j + 1) % n].y);
+
+					CGAL::Comparison_result order = CGAL::compare_xy(a, b);
+					if (order == CGAL::EQUAL) continue;
+
+					curves.push_back(Curve(Segment(a, b), EncodeEdge(i, layerIndex, order == CGAL::SMALLER)));
+				}
+			}
+		}
+	}
+
+	//Labels the face across the halfedge. Outer boundaries are counter
+	//clockwise and holes clockwise so a polygon's interior is always to the
+	//left of its edges as given. Edges of the other layer leave the label as is.
+	void LabelAcross(Arrangement::Halfedge_handle h, FaceLabel& label)
+	{
+		Arrangement::Halfedge_handle across = h->twin();
+		bool leftToRight = across->direction() == CGAL::ARR_LEFT_TO_RIGHT;
+
+		bool crossesA = false, crossesB = false;
+		int a = -1, b = -1;
+
+		for (auto code = across->curve().data().begin(); code != across->curve().data().end(); ++code)
+		{
+			int polygon = *code >> 2;
+			int layer = (*code >> 1) & 1;
+			bool inside = ((*code & 1) == 0) == leftToRight;
+
+			if (layer == 0)
+			{
+				crossesA = true;
+				if (inside) a = polygon;
+			}
+			else
+			{
+				crossesB = true;
+				if (inside) b = polygon;
+			}
+		}
+
+		if (crossesA) label.a = a;
+		if (crossesB) label.b = b;
+	}
+
+	//Walks the faces outwards from the unbounded one, which no polygon covers.
+	void LabelFaces(Arrangement& arr)
+	{
+		queue<Arrangement::Face_handle> open;
+
+		arr.unbounded_face()->data().visited = true;
+		open.push(arr.unbounded_face());
+
+		auto visit = [&](Arrangement::Face_handle face, Arrangement::Ccb_halfedge_circulator start)
+		{
+			Arrangement::Ccb_halfedge_circulator h = start;
+			do
+			{
+				Arrangement::Face_handle next = h->twin()->face();
+
+				if (!next->data().visited)
+				{
+					FaceLabel label = face->data();
+					LabelAcross(h, label);
+					next->set_data(label);
+					open.push(next);
+				}
+			} while (++h != start);
+		};
+
+		while (!open.empty())
+		{
+			Arrangement::Face_handle face = open.front();
+			open.pop();
+
+			if (!face->is_unbounded())
+				visit(face, face->outer_ccb());
+
+			for (auto ccb = face->inner_ccbs_begin(); ccb != face->inner_ccbs_end(); ++ccb)
+				visit(face, *ccb);
+		}
+	}
+
+	double AddRing(Arrangement::Ccb_halfedge_const_circulator start)
+	{
+		faces.pointOffsets.push_back(int(faces.points.size()));
+		size_t first = faces.points.size();
+
+		Arrangement::Ccb_halfedge_const_circulator h = start;
+		do
+		{
+			float x = float(CGAL::to_double(h->source()->point().x()));
+			float y = float(CGAL::to_double(h->source()->point().y()));
+			faces.points.push_back({ x, y });
+		} while (++h != start);
+
+		int n = int(faces.points.size() - first);
+		faces.ringSizes.push_back(n);
+
+		double area = 0;
+		for (int i = 0; i < n; i++)
+		{
+			const Point2f& p0 = faces.points[first + i];
+			const Point2f& p1 = faces.points[first + (i + 1) % n];
+			area += double(p0.x) * p1.y - double(p1.x) * p0.y;
+		}
+
+		return area * 0.5;
+	}
+
+	CGALWRAPPERAPI void CALLCON Overlay2_A_LoadPolygons2f(const Point2f* inPoints, const int* inRingSizes, const int* inPolygonRings, int numPolygons)
+	{
+		layerA.Load(inPoints, inRingSizes, inPolygonRings, numPolygons);
+	}
+
+	CGALWRAPPERAPI void CALLCON Overlay2_B_LoadPolygons2f(const Point2f* inPoints, const int* inRingSizes, const int* inPolygonRings, int numPolygons)
+	{
+		layerB.Load(inPoints, inRingSizes, inPolygonRings, numPolygons);
+	}
+
+	CGALWRAPPERAPI void CALLCON Overlay2_Clear()
+	{
+		layerA.Clear();
+		layerB.Clear();
+		faces.Clear();
+		sources.clear();
+	}
+
+	CGALWRAPPERAPI void CALLCON Overlay2_Release()
+	{
+		layerA.Release();
+		layerB.Release();
+		faces.Release();
+		sources.resize(0);
+	}
+
+	//Inserts the edges of both layers into one arrangement with a single sweep
+	//and labels every face with the polygon of each layer covering it. The
+	//polygons within a layer must not overlap. Faces covered by either layer
+	//are output, or only those covered by both if intersectionOnly is set.
+	CGALWRAPPERAPI CGALResult CALLCON Overlay2_Compute(BOOL intersectionOnly, PolygonBufferDescriptor& descriptor)
+	{
+		try
+		{
+			faces.Clear();
+			sources.clear();
+
+			vector<Curve> curves;
+			AddEdges(layerA, 0, curves);
+			AddEdges(layerB, 1, curves);
+
+			Arrangement arr;
+			CGAL::insert(arr, curves.begin(), curves.end());
+
+			LabelFaces(arr);
+
+			for (auto face = arr.faces_begin(); face != arr.faces_end(); ++face)
+			{
+				if (face->is_unbounded()) continue;
+
+				const FaceLabel& label = face->data();
+				if (label.a == -1 && label.b == -1) continue;
+				if (intersectionOnly && (label.a == -1 || label.b == -1)) continue;
+
+				faces.ringOffsets.push_back(int(faces.ringSizes.size()));
+				faces.polygonRings.push_back(1 + int(std::distance(face->inner_ccbs_begin(), face->inner_ccbs_end())));
+
+				double area = AddRing(face->outer_ccb());
+				for (auto ccb = face->inner_ccbs_begin(); ccb != face->inner_ccbs_end(); ++ccb)
+					area += AddRing(*ccb);
+
+				sources.push_back({ label.a, label.b, area });
+			}
+
+			descriptor = faces.Descriptor();
+			return CGAL_SUCCESS;
+		}
+		catch (...)
+		{
+			faces.Clear();
+			sources.clear();
+			descriptor = faces.Descriptor();
+			return CGAL_ERROR;
+		}
+	}
+
+	//Copies out the faces and the polygon of each layer covering each face,
+	//-1 if none, with the face's area.
+	CGALWRAPPERAPI void CALLCON Overlay2_GetFaces2f(Point2f* outPoints, int* outRingSizes, int* outPolygonRings, PolygonPair* outSources)
+	{
+		faces.CopyTo(outPoints, outRingSizes, outPolygonRings);
+
+		if (outSources != nullptr)
+			std::copy(sources.begin(), sources.end(), outSources);
+	}
+
+}
\ No newline at end of file
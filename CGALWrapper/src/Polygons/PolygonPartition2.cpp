@@ -1,6 +1,9 @@
 
 #include "stdafx.h"
 #include "Polygons/PolygonPartition2.h"
+#include "Utility/ParallelFor.h"
+#include "Utility/PolygonDomains.h"
+#include "Primatives/PolygonBuffer2.h"
 
 #include <CGAL/Exact_predicates_inexact_constructions_kernel.h>
 #include <CGAL/Polygon_2.h>
@@ -16,9 +19,229 @@ namespace PolygonPartition2
 	typedef CGAL::Partition_traits_2<K> Traits;
 	typedef Traits::Point_2 Point;
 	typedef Traits::Polygon_2 Polygon;
+	typedef Utility::DomainTriangulation<K>::CDT CDT;
+
+	enum Method { APPROX, GREENE, YMONOTONE, OPTIMAL, AUTO, TRIANGULATION };
+
+	//Greene's dynamic program behind optimal_convex_partition_2 is O(n^4) in
+	//the worst case. The auto mode estimates its cost as n^2 * (r + 1)^2 for
+	//n vertices and r reflex vertices and only runs it within the budget.
+	const double DEFAULT_OPTIMAL_BUDGET = 5e7;
 
 	Polygon polygon;
 	vector<Polygon> partition;
+	PartitionReport report = { APPROX, 0, 0 };
+
+	double optimalBudget = DEFAULT_OPTIMAL_BUDGET;
+	int autoFallback = GREENE;
+
+	vector<Point2f> batchPoints;
+	vector<int> batchPolygonOffsets;
+	vector<int> batchPartOffsets;
+	vector<PartitionReport> batchReports;
+
+	int CountReflex(const Polygon& input)
+	{
+		int size = int(input.size());
+		int count = 0;
+
+		for (int i = 0; i < size; i++)
+		{
+			const Point& a = input[(i + size - 1) % size];
+			const Point& b = input[i];
+			const Point& c = input[(i + 1) % size];
+
+			if (CGAL::orientation(a, b, c) == CGAL::RIGHT_TURN)
+				count++;
+		}
+
+		return count;
+	}
+
+	int ChooseMethod(int numVertices, int numReflex)
+	{
+		double n = numVertices, r = numReflex + 1.0;
+		return (n * n * r * r <= optimalBudget) ? OPTIMAL : autoFallback;
+	}
+
+	//Every diagonal removes at most two reflex vertices, so no convex
+	//partition has fewer than ceil(r / 2) + 1 parts.
+	PartitionReport PartitionPolygon(const Polygon& input, int method, list<Polygon>& parts)
+	{
+		int reflex = CountReflex(input);
+
+		PartitionReport result;
+		result.lowerBound = (reflex + 1) / 2 + 1;
+
+		if (method == AUTO)
+		{
+			if (reflex == 0)
+			{
+				parts.push_back(input);
+				result.method = OPTIMAL;
+				result.parts = 1;
+				return result;
+			}
+
+			method = ChooseMethod(int(input.size()), reflex);
+		}
+
+		switch (method)
+		{
+		case APPROX:
+			CGAL::approx_convex_partition_2(input.vertices_begin(), input.vertices_end(), back_inserter(parts));
+			break;
+
+		case GREENE:
+			CGAL::greene_approx_convex_partition_2(input.vertices_begin(), input.vertices_end(), back_inserter(parts));
+			break;
+
+		case YMONOTONE:
+			CGAL::y_monotone_partition_2(input.vertices_begin(), input.vertices_end(), back_inserter(parts));
+			break;
+
+		case OPTIMAL:
+			CGAL::optimal_convex_partition_2(input.vertices_begin(), input.vertices_end(), back_inserter(parts));
+			break;
+		}
+
+		result.method = method;
+		result.parts = int(parts.size());
+		return result;
+	}
+
+	//Triangulates the polygon with holes and then removes diagonals,
+	//Hertel-Mehlhorn style, wherever both of its ends stay convex. Half edge
+	//3 * f + k of domain face f runs from its vertex k to vertex k + 1.
+	//With h holes, d diagonals leave d + 1 - h parts, which lowers the bound.
+	PartitionReport TriangulationPartition(const PolygonBuffer2f& buffer, int index, list<Polygon>& parts)
+	{
+		CDT cdt;
+		int ring = buffer.ringOffsets[index];
+		int reflex = 0;
+
+		for (int i = 0; i < buffer.polygonRings[index]; i++)
+		{
+			vector<Point> points = ToPointArray2<Point, Point2f>(buffer.RingPoints(ring + i), buffer.ringSizes[ring + i]);
+			cdt.insert_constraint(points.begin(), points.end(), true);
+
+			//Holes are clockwise so their right turns are reflex too.
+			reflex += CountReflex(Polygon(points.begin(), points.end()));
+		}
+
+		Utility::MarkDomains(cdt);
+
+		vector<CDT::Face_handle> faces;
+		for (auto face = cdt.finite_faces_begin(); face != cdt.finite_faces_end(); ++face)
+		{
+			if (!face->info().InDomain()) continue;
+
+			face->info().id = int(faces.size());
+			faces.push_back(face);
+		}
+
+		int numHalfEdges = int(faces.size()) * 3;
+		vector<int> next(numHalfEdges), prev(numHalfEdges);
+		vector<unsigned char> removed(numHalfEdges, 0);
+
+		for (int h = 0; h < numHalfEdges; h++)
+		{
+			next[h] = h - h % 3 + (h + 1) % 3;
+			prev[h] = h - h % 3 + (h + 2) % 3;
+		}
+
+		auto Origin = [&](int h) -> const Point&
+		{
+			return faces[h / 3]->vertex(h % 3)->point();
+		};
+
+		auto Twin = [&](int h) -> int
+		{
+			CDT::Face_handle face = faces[h / 3];
+			int i = (h % 3 + 2) % 3;
+
+			CDT::Face_handle n = face->neighbor(i);
+			if (n->info().id == -1 || cdt.is_constrained(CDT::Edge(face, i))) return -1;
+
+			return 3 * n->info().id + (n->index(face) + 1) % 3;
+		};
+
+		for (int h = 0; h < numHalfEdges; h++)
+		{
+			int t = Twin(h);
+			if (t < h || removed[h]) continue;
+
+			const Point& u = Origin(h);
+			const Point& v = Origin(t);
+
+			if (CGAL::orientation(Origin(prev[h]), u, Origin(next[next[t]])) == CGAL::RIGHT_TURN) continue;
+			if (CGAL::orientation(Origin(prev[t]), v, Origin(next[next[h]])) == CGAL::RIGHT_TURN) continue;
+
+			int ph = prev[h], nh = next[h];
+			int pt = prev[t], nt = next[t];
+
+			next[ph] = nt;
+			prev[nt] = ph;
+			next[pt] = nh;
+			prev[nh] = pt;
+
+			removed[h] = removed[t] = 1;
+		}
+
+		vector<unsigned char> visited(numHalfEdges, 0);
+		vector<Point> points;
+
+		for (int h = 0; h < numHalfEdges; h++)
+		{
+			if (removed[h] || visited[h]) continue;
+
+			points.clear();
+			int e = h;
+
+			do
+			{
+				visited[e] = 1;
+
+				if (CGAL::orientation(Origin(prev[e]), Origin(e), Origin(next[e])) != CGAL::COLLINEAR)
+					points.push_back(Origin(e));
+
+				e = next[e];
+			} while (e != h);
+
+			parts.push_back(Polygon(points.begin(), points.end()));
+		}
+
+		PartitionReport result;
+		result.method = TRIANGULATION;
+		result.parts = int(parts.size());
+		result.lowerBound = (std::max)(1, (reflex + 1) / 2 + 1 - buffer.NumHoles(index));
+
+		return result;
+	}
+
+	void StoreBatch(const vector<list<Polygon>>& results)
+	{
+		for (size_t i = 0; i < results.size(); i++)
+		{
+			for (const Polygon& part : results[i])
+			{
+				for (auto p = part.vertices_begin(); p != part.vertices_end(); ++p)
+					batchPoints.push_back({ float((*p)[0]), float((*p)[1]) });
+
+				batchPartOffsets.push_back(int(batchPoints.size()));
+			}
+
+			batchPolygonOffsets.push_back(int(batchPartOffsets.size()) - 1);
+		}
+	}
+
+	void ClearBatch()
+	{
+		batchPoints.clear();
+		batchPolygonOffsets.assign(1, 0);
+		batchPartOffsets.assign(1, 0);
+		batchReports.clear();
+	}
 
 	CGALWRAPPERAPI void CALLCON Partition2_LoadPoints2f(const Point2f* inPoints, int inSize)
 	{
@@ -30,12 +253,20 @@ namespace PolygonPartition2
 	{
 		polygon.clear();
 		partition.clear();
+		batchPoints.clear();
+		batchPolygonOffsets.clear();
+		batchPartOffsets.clear();
+		batchReports.clear();
 	}
 
 	CGALWRAPPERAPI void CALLCON Partition2_Release()
 	{
 		polygon = Polygon();
 		partition.resize(0);
+		batchPoints.resize(0);
+		batchPolygonOffsets.resize(0);
+		batchPartOffsets.resize(0);
+		batchReports.resize(0);
 	}
 
 	CGALWRAPPERAPI int CALLCON Partition2_ApproxConvexPartition()
@@ -43,7 +274,7 @@ namespace PolygonPartition2
 		try
 		{
 			list<Polygon> tmp;
-			CGAL::approx_convex_partition_2(polygon.vertices_begin(), polygon.vertices_end(), back_inserter(tmp));
+			report = PartitionPolygon(polygon, APPROX, tmp);
 			partition = { begin(tmp), end(tmp) };
 
 			return int(partition.size());
@@ -59,7 +290,7 @@ namespace PolygonPartition2
 		try
 		{
 			list<Polygon> tmp;
-			CGAL::greene_approx_convex_partition_2(polygon.vertices_begin(), polygon.vertices_end(), back_inserter(tmp));
+			report = PartitionPolygon(polygon, GREENE, tmp);
 			partition = { begin(tmp), end(tmp) };
 
 			return int(partition.size());
@@ -75,7 +306,7 @@ namespace PolygonPartition2
 		try
 		{
 			list<Polygon> tmp;
-			CGAL::y_monotone_partition_2(polygon.vertices_begin(), polygon.vertices_end(), back_inserter(tmp));
+			report = PartitionPolygon(polygon, YMONOTONE, tmp);
 			partition = { begin(tmp), end(tmp) };
 
 			return int(partition.size());
@@ -91,7 +322,7 @@ namespace PolygonPartition2
 		try
 		{
 			list<Polygon> tmp;
-			CGAL::optimal_convex_partition_2(polygon.vertices_begin(), polygon.vertices_end(), back_inserter(tmp));
+			report = PartitionPolygon(polygon, OPTIMAL, tmp);
 			partition = { begin(tmp), end(tmp) };
 
 			return int(partition.size());
@@ -102,6 +333,34 @@ namespace PolygonPartition2
 		}
 	}
 
+	CGALWRAPPERAPI int CALLCON Partition2_AutoPartition()
+	{
+		try
+		{
+			list<Polygon> tmp;
+			report = PartitionPolygon(polygon, AUTO, tmp);
+			partition = { begin(tmp), end(tmp) };
+
+			return int(partition.size());
+		}
+		catch (...)
+		{
+			return 0;
+		}
+	}
+
+	//A negative budget restores the default.
+	CGALWRAPPERAPI void CALLCON Partition2_SetAutoPartition(double budget, int fallbackMethod)
+	{
+		optimalBudget = (budget < 0) ? DEFAULT_OPTIMAL_BUDGET : budget;
+		autoFallback = (fallbackMethod == APPROX) ? APPROX : GREENE;
+	}
+
+	CGALWRAPPERAPI PartitionReport CALLCON Partition2_GetReport()
+	{
+		return report;
+	}
+
 	CGALWRAPPERAPI int CALLCON Partition2_GetPolygonSize(int i)
 	{
 		return int(partition[i].size());
@@ -113,4 +372,101 @@ namespace PolygonPartition2
 		return { float(p[0]) , float(p[1]) };
 	}
 
+	//Partitions each polygon on its own thread. A polygon whose partition
+	//fails is given no parts. Returns the total number of parts.
+	CGALWRAPPERAPI int CALLCON Partition2_BatchPartition2f(const Point2f* inPoints, const int* inSizes, int numPolygons, int method)
+	{
+		try
+		{
+			ClearBatch();
+			if (numPolygons < 1) return 0;
+
+			vector<int> pointOffsets(numPolygons + 1, 0);
+			for (int i = 0; i < numPolygons; i++)
+				pointOffsets[i + 1] = pointOffsets[i] + inSizes[i];
+
+			vector<list<Polygon>> results(numPolygons);
+			batchReports.assign(numPolygons, { method, 0, 0 });
+
+			Utility::ParallelFor(numPolygons, [&](int i)
+			{
+				try
+				{
+					vector<Point> points = ToPointArray2<Point, Point2f>(inPoints + pointOffsets[i], inSizes[i]);
+					batchReports[i] = PartitionPolygon(Polygon(points.begin(), points.end()), method, results[i]);
+				}
+				catch (...)
+				{
+					results[i].clear();
+					batchReports[i].parts = 0;
+				}
+			});
+
+			StoreBatch(results);
+			return int(batchPartOffsets.size()) - 1;
+		}
+		catch (...)
+		{
+			ClearBatch();
+			return 0;
+		}
+	}
+
+	//Convex partition of polygons with holes in the flat buffer layout. The
+	//result is read back with the same calls as the batch partition.
+	CGALWRAPPERAPI int CALLCON Partition2_TriangulationPartition2f(const Point2f* inPoints, const int* inRingSizes, const int* inPolygonRings, int numPolygons)
+	{
+		try
+		{
+			ClearBatch();
+			if (numPolygons < 1) return 0;
+
+			PolygonBuffer2f buffer;
+			buffer.Load(inPoints, inRingSizes, inPolygonRings, numPolygons);
+
+			vector<list<Polygon>> results(numPolygons);
+			batchReports.assign(numPolygons, { TRIANGULATION, 0, 0 });
+
+			Utility::ParallelFor(numPolygons, [&](int i)
+			{
+				try
+				{
+					batchReports[i] = TriangulationPartition(buffer, i, results[i]);
+				}
+				catch (...)
+				{
+					results[i].clear();
+					batchReports[i].parts = 0;
+				}
+			});
+
+			StoreBatch(results);
+			return int(batchPartOffsets.size()) - 1;
+		}
+		catch (...)
+		{
+			ClearBatch();
+			return 0;
+		}
+	}
+
+	CGALWRAPPERAPI int CALLCON Partition2_BatchNumPoints()
+	{
+		return int(batchPoints.size());
+	}
+
+	//Polygon i owns parts [outPolygonOffsets[i], outPolygonOffsets[i + 1]) and
+	//part j owns points [outPartOffsets[j], outPartOffsets[j + 1]).
+	CGALWRAPPERAPI void CALLCON Partition2_GetBatchPartition2f(Point2f* outPoints, int* outPolygonOffsets, int* outPartOffsets)
+	{
+		copy(batchPoints.begin(), batchPoints.end(), outPoints);
+		copy(batchPolygonOffsets.begin(), batchPolygonOffsets.end(), outPolygonOffsets);
+		copy(batchPartOffsets.begin(), batchPartOffsets.end(), outPartOffsets);
+	}
+
+	CGALWRAPPERAPI void CALLCON Partition2_GetBatchReports(PartitionReport* outReports)
+	{
+		copy(batchReports.begin(), batchReports.end(), outReports);
+	}
+
 }
\ No newline at end of file
@@ -0,0 +1,287 @@
+
+#include "stdafx.h"
+#include "Polygons/PolygonSet2.h"
+
+#include <CGAL/Exact_predicates_exact_constructions_kernel.h>
+#include <CGAL/Boolean_set_operations_2.h>
+#include <CGAL/Polygon_set_2.h>
+
+#include <map>
+#include <algorithm>
+
+using namespace std;
+
+namespace PolygonSet2
+{
+
+	typedef CGAL::Exact_predicates_exact_constructions_kernel Kernel;
+	typedef Kernel::Point_2 Point;
+	typedef CGAL::Polygon_2<Kernel> Polygon;
+	typedef CGAL::Polygon_with_holes_2<Kernel> PolygonWithHoles;
+	typedef CGAL::Polygon_set_2<Kernel> PolygonSet;
+
+	enum Operation { JOIN, DIFFERENCE, INTERSECT };
+
+	struct Component
+	{
+		PolygonWithHoles polygon;
+		CGAL::Bbox_2 box;
+	};
+
+	PolygonWithHoles brush;
+	map<int, Component> components;
+	int nextId = 0;
+
+	vector<int> added, removed;
+
+	PolygonWithHoles focusPolygon;
+	vector<PolygonWithHoles> focusHoles;
+
+	void AddComponent(const PolygonWithHoles& polygon)
+	{
+		Component component;
+		component.polygon = polygon;
+		component.box = polygon.outer_boundary().bbox();
+
+		int id = nextId++;
+		components.insert(pair<int, Component>(id, component));
+		added.push_back(id);
+	}
+
+	void RemoveComponent(int id)
+	{
+		components.erase(id);
+
+		auto it = find(added.begin(), added.end(), id);
+		if (it != added.end())
+			added.erase(it);
+		else
+			removed.push_back(id);
+	}
+
+	void RemoveAll()
+	{
+		vector<int> ids;
+		for (auto it = components.begin(); it != components.end(); ++it)
+			ids.push_back(it->first);
+
+		for (int id : ids)
+			RemoveComponent(id);
+	}
+
+	void FindAffected(const CGAL::Bbox_2& box, vector<int>& ids)
+	{
+		for (auto it = components.begin(); it != components.end(); ++it)
+		{
+			if (CGAL::do_overlap(box, it->second.box))
+				ids.push_back(it->first);
+		}
+	}
+
+	CGALResult Apply(Operation op)
+	{
+		try
+		{
+			vector<int> affected;
+			FindAffected(brush.outer_boundary().bbox(), affected);
+
+			if (affected.size() == 0)
+			{
+				if (op == JOIN)
+					AddComponent(brush);
+				else if (op == INTERSECT)
+					RemoveAll();
+
+				return CGAL_SUCCESS;
+			}
+
+			vector<PolygonWithHoles> polygons;
+			polygons.reserve(affected.size());
+			for (int id : affected)
+				polygons.push_back(components[id].polygon);
+
+			PolygonSet local;
+			local.join(polygons.begin(), polygons.end());
+
+			switch (op)
+			{
+			case JOIN:
+				local.join(brush);
+				break;
+
+			case DIFFERENCE:
+				local.difference(brush);
+				break;
+
+			case INTERSECT:
+				local.intersection(brush);
+				break;
+			}
+
+			vector<PolygonWithHoles> result;
+			local.polygons_with_holes(back_inserter(result));
+
+			if (op == INTERSECT)
+				RemoveAll();
+			else
+			{
+				for (int id : affected)
+					RemoveComponent(id);
+			}
+
+			for (auto& polygon : result)
+				AddComponent(polygon);
+
+			return CGAL_SUCCESS;
+		}
+		catch (...)
+		{
+			return CGAL_ERROR;
+		}
+	}
+
+	CGALWRAPPERAPI void CALLCON PolygonSet2_LoadBrush2f(const Point2f* inPoints, int inSize)
+	{
+		vector<Point> points = ToPointArray2<Point, Point2f>(inPoints, inSize);
+		brush = PolygonWithHoles(Polygon(points.begin(), points.end()));
+	}
+
+	CGALWRAPPERAPI void CALLCON PolygonSet2_AddBrushHole2f(const Point2f* inPoints, int inSize)
+	{
+		vector<Point> points = ToPointArray2<Point, Point2f>(inPoints, inSize);
+		brush.add_hole(Polygon(points.begin(), points.end()));
+	}
+
+	CGALWRAPPERAPI void CALLCON PolygonSet2_Clear()
+	{
+		RemoveAll();
+		brush.clear();
+		focusPolygon.clear();
+		focusHoles.clear();
+	}
+
+	CGALWRAPPERAPI void CALLCON PolygonSet2_Release()
+	{
+		brush = PolygonWithHoles();
+		components.clear();
+		nextId = 0;
+		added.resize(0);
+		removed.resize(0);
+		focusPolygon = PolygonWithHoles();
+		focusHoles.resize(0);
+	}
+
+	//The brush must not overlap the set. No overlay is computed.
+	CGALWRAPPERAPI CGALResult CALLCON PolygonSet2_Insert()
+	{
+		try
+		{
+			AddComponent(brush);
+			return CGAL_SUCCESS;
+		}
+		catch (...)
+		{
+			return CGAL_ERROR;
+		}
+	}
+
+	CGALWRAPPERAPI CGALResult CALLCON PolygonSet2_Join()
+	{
+		return Apply(JOIN);
+	}
+
+	CGALWRAPPERAPI CGALResult CALLCON PolygonSet2_Difference()
+	{
+		return Apply(DIFFERENCE);
+	}
+
+	CGALWRAPPERAPI CGALResult CALLCON PolygonSet2_Intersect()
+	{
+		return Apply(INTERSECT);
+	}
+
+	CGALWRAPPERAPI int CALLCON PolygonSet2_NumPolygons()
+	{
+		return int(components.size());
+	}
+
+	//Ids of every polygon in one pass over the map.
+	CGALWRAPPERAPI void CALLCON PolygonSet2_GetPolygonIds(int* outIds)
+	{
+		int i = 0;
+		for (auto& component : components)
+			outIds[i++] = component.first;
+	}
+
+	CGALWRAPPERAPI int CALLCON PolygonSet2_NumAdded()
+	{
+		return int(added.size());
+	}
+
+	CGALWRAPPERAPI void CALLCON PolygonSet2_GetAddedIds(int* outIds)
+	{
+		copy(added.begin(), added.end(), outIds);
+	}
+
+	CGALWRAPPERAPI int CALLCON PolygonSet2_NumRemoved()
+	{
+		return int(removed.size());
+	}
+
+	CGALWRAPPERAPI void CALLCON PolygonSet2_GetRemovedIds(int* outIds)
+	{
+		copy(removed.begin(), removed.end(), outIds);
+	}
+
+	CGALWRAPPERAPI void CALLCON PolygonSet2_ClearChanges()
+	{
+		added.clear();
+		removed.clear();
+	}
+
+	CGALWRAPPERAPI BOOL CALLCON PolygonSet2_PointToPolygon(int id)
+	{
+		auto it = components.find(id);
+		if (it == components.end()) return false;
+
+		focusPolygon = it->second.polygon;
+		focusHoles = vector<PolygonWithHoles>(focusPolygon.holes_begin(), focusPolygon.holes_end());
+		return true;
+	}
+
+	CGALWRAPPERAPI int CALLCON PolygonSet2_NumPolygonPoints()
+	{
+		return int(focusPolygon.outer_boundary().size());
+	}
+
+	CGALWRAPPERAPI int CALLCON PolygonSet2_NumPolygonHoles()
+	{
+		return int(focusHoles.size());
+	}
+
+	CGALWRAPPERAPI int CALLCON PolygonSet2_NumHolePoints(int holeIndex)
+	{
+		return int(focusHoles[holeIndex].outer_boundary().size());
+	}
+
+	CGALWRAPPERAPI Point2f CALLCON PolygonSet2_GetPolygonPoint2f(int pointIndex)
+	{
+		Point p = focusPolygon.outer_boundary()[pointIndex];
+
+		float x = float(CGAL::to_double(p.x()));
+		float y = float(CGAL::to_double(p.y()));
+
+		return{ x, y };
+	}
+
+	CGALWRAPPERAPI Point2f CALLCON PolygonSet2_GetHolePoint2f(int holeIndex, int pointIndex)
+	{
+		Point p = focusHoles[holeIndex].outer_boundary()[pointIndex];
+
+		float x = float(CGAL::to_double(p.x()));
+		float y = float(CGAL::to_double(p.y()));
+
+		return{ x, y };
+	}
+
+}
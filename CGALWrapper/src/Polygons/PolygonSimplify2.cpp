@@ -1,10 +1,23 @@
 
 #include "stdafx.h"
 #include "Polygons/PolygonSimplify2.h"
+#include "Primatives/PolygonBuffer2.h"
+#include "Utility/ParallelFor.h"
+#include "Utility/PolygonDomains.h"
 
 #include <CGAL/Exact_predicates_inexact_constructions_kernel.h>
 #include <CGAL/Polygon_2.h>
+#include <CGAL/Constrained_Delaunay_triangulation_2.h>
+#include <CGAL/Constrained_triangulation_plus_2.h>
+#include <CGAL/Triangulation_vertex_base_with_info_2.h>
 #include <CGAL/Polyline_simplification_2/simplify.h>
+#include <CGAL/Polyline_simplification_2/Stop_above_cost_threshold.h>
+#include <CGAL/Polyline_simplification_2/Stop_below_count_threshold.h>
+#include <CGAL/box_intersection_d.h>
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
 
 using namespace std;
 
@@ -17,7 +30,320 @@ namespace PolygonSimplify2
 	typedef CGAL::Polygon_2<K> Polygon;
 	typedef PS::Stop_below_count_ratio_threshold Stop;
 
+	typedef CGAL::Triangulation_vertex_base_with_info_2<int, K> Vbb;
+	typedef PS::Vertex_base_2<K, Vbb> Vb;
+	typedef CGAL::Constrained_triangulation_face_base_2<K> Fb;
+	typedef CGAL::Triangulation_data_structure_2<Vb, Fb> TDS;
+	typedef CGAL::Constrained_Delaunay_triangulation_2<K, TDS, CGAL::Exact_predicates_tag> CDT;
+	typedef CGAL::Constrained_triangulation_plus_2<CDT> CT;
+
+	typedef CGAL::Box_intersection_d::Box_with_handle_d<double, 2, const int*> Box;
+
+	enum Method { SQUARE_DIST, SCALED_SQUARE_DIST };
+
+	enum StopCriterion { COUNT_RATIO, COST, COUNT };
+
+	//Vertices of the loaded polygon in the order the simplification
+	//removed them, with the cost of each removal.
+	struct RemovalOrder
+	{
+		vector<int> indices;
+		vector<double> costs;
+
+		//Highest cost offered so far and the removals made before each offer.
+		//The stop criteria see blocked vertices as well as removed ones.
+		vector<double> offeredCosts;
+		vector<int> offeredRemovals;
+
+		int pendingIndex;
+		double pendingCost;
+		size_t pendingCount;
+	};
+
+	//Never stops the simplification but records each vertex it is offered.
+	//The vertex was only removed if the vertex count has dropped by the
+	//time the next one is offered, as blocked vertices are skipped.
+	struct RecordingStop
+	{
+		RemovalOrder* order;
+
+		RecordingStop(RemovalOrder* order) : order(order) {}
+
+		void Flush(size_t currentCount) const
+		{
+			if (order->pendingIndex != -1 && currentCount < order->pendingCount)
+			{
+				order->indices.push_back(order->pendingIndex);
+				order->costs.push_back(order->pendingCost);
+			}
+
+			order->pendingIndex = -1;
+		}
+
+		template <class TRIANGULATION>
+		bool operator()(const TRIANGULATION&, typename TRIANGULATION::Vertex_handle v, double cost, size_t initialCount, size_t currentCount) const
+		{
+			Flush(currentCount);
+
+			double highest = order->offeredCosts.empty() ? cost : (std::max)(cost, order->offeredCosts.back());
+			order->offeredCosts.push_back(highest);
+			order->offeredRemovals.push_back(int(order->indices.size()));
+
+			order->pendingIndex = v->info();
+			order->pendingCost = cost;
+			order->pendingCount = currentCount;
+
+			return false;
+		}
+	};
+
+	//An open polyline simplified a window at a time. Only the window and the
+	//output not yet collected are held, however long the polyline is.
+	struct PolylineStream
+	{
+		int method;
+		float threshold;
+		int windowSize;
+		bool started;
+
+		vector<Point> window;
+		vector<Point2f> output;
+	};
+
 	Polygon polygon, simplified;
+	RemovalOrder removalOrder;
+	vector<int> levelCounts;
+	PolygonBuffer2f batchOutput;
+	PolylineStream stream;
+
+	void RecordRemovalOrder(const Polygon& input, int method, RemovalOrder& order)
+	{
+		order.indices.clear();
+		order.costs.clear();
+		order.offeredCosts.clear();
+		order.offeredRemovals.clear();
+		order.pendingIndex = -1;
+
+		CT ct;
+		for (int i = 0; i < int(input.size()); i++)
+			ct.insert(input[i])->info() = i;
+
+		ct.insert_constraint(input.vertices_begin(), input.vertices_end(), true);
+
+		RecordingStop stop(&order);
+
+		if (method == SCALED_SQUARE_DIST)
+			PS::simplify(ct, PS::Scaled_squared_distance_cost(), stop);
+		else
+			PS::simplify(ct, PS::Squared_distance_cost(), stop);
+
+		stop.Flush(ct.number_of_vertices());
+	}
+
+	template <class STOP>
+	int SimplifyLoaded(int method, const STOP& stop)
+	{
+		if (method == SCALED_SQUARE_DIST)
+			simplified = PS::simplify(polygon, PS::Scaled_squared_distance_cost(), stop);
+		else
+			simplified = PS::simplify(polygon, PS::Squared_distance_cost(), stop);
+
+		return int(simplified.size());
+	}
+
+	//Number of removals the simplification would make before the stop
+	//criterion fires, read from a removal order run to completion.
+	int RemovalsBeforeStop(const RemovalOrder& order, int size, int criterion, float threshold)
+	{
+		int total = int(order.indices.size());
+
+		if (criterion == COST)
+		{
+			auto first = upper_bound(order.offeredCosts.begin(), order.offeredCosts.end(), double(threshold));
+			if (first == order.offeredCosts.end()) return total;
+
+			return order.offeredRemovals[first - order.offeredCosts.begin()];
+		}
+
+		int count;
+		if (criterion == COUNT)
+			count = int(threshold);
+		else
+		{
+			count = int(std::floor(size * double(threshold)));
+			while (count + 1 <= size && double(count + 1) / size <= threshold) count++;
+			while (count > 0 && double(count) / size > threshold) count--;
+		}
+
+		return (std::max)(0, (std::min)(total, size - count));
+	}
+
+	//Simplification keeps each ring inside its bounding box, so polygons whose
+	//boxes are not connected through overlaps can be simplified independently.
+	void FindComponents(const PolygonBuffer2f& buffer, vector<vector<int>>& components)
+	{
+		int count = buffer.NumPolygons();
+		vector<int> indices(count), parent(count);
+		vector<Box> boxes;
+		boxes.reserve(count);
+
+		for (int i = 0; i < count; i++)
+		{
+			indices[i] = parent[i] = i;
+			boxes.push_back(Box(buffer.Bbox(i), &indices[i]));
+		}
+
+		auto report = [&](const Box& a, const Box& b)
+		{
+			int ra = Utility::FindRoot(parent, *a.handle());
+			int rb = Utility::FindRoot(parent, *b.handle());
+			if (ra != rb) parent[ra] = rb;
+		};
+
+		CGAL::box_self_intersection_d(boxes.begin(), boxes.end(), report);
+
+		vector<int> component(count, -1);
+		for (int i = 0; i < count; i++)
+		{
+			int root = Utility::FindRoot(parent, i);
+			if (component[root] == -1)
+			{
+				component[root] = int(components.size());
+				components.push_back(vector<int>());
+			}
+
+			components[component[root]].push_back(i);
+		}
+
+		sort(components.begin(), components.end(), [](const vector<int>& a, const vector<int>& b)
+		{
+			return a.size() > b.size();
+		});
+	}
+
+	//All rings of the component go into one triangulation so boundaries
+	//shared by several polygons are simplified once and stay shared.
+	void SimplifyComponent(const PolygonBuffer2f& buffer, const vector<int>& component, float threshold, int method, vector<vector<Point2f>>& rings)
+	{
+		CT ct;
+		vector<CT::Constraint_id> ids;
+
+		for (int index : component)
+		{
+			int ring = buffer.ringOffsets[index];
+			for (int i = 0; i < buffer.polygonRings[index]; i++)
+			{
+				vector<Point> points = ToPointArray2<Point, Point2f>(buffer.RingPoints(ring + i), buffer.ringSizes[ring + i]);
+				ids.push_back(ct.insert_constraint(points.begin(), points.end(), true));
+			}
+		}
+
+		if (method == SCALED_SQUARE_DIST)
+			PS::simplify(ct, PS::Scaled_squared_distance_cost(), Stop(threshold));
+		else
+			PS::simplify(ct, PS::Squared_distance_cost(), Stop(threshold));
+
+		int id = 0;
+		for (int index : component)
+		{
+			int ring = buffer.ringOffsets[index];
+			for (int i = 0; i < buffer.polygonRings[index]; i++, id++)
+			{
+				vector<Point2f>& out = rings[ring + i];
+
+				for (auto v = ct.vertices_in_constraint_begin(ids[id]); v != ct.vertices_in_constraint_end(ids[id]); ++v)
+				{
+					const Point& p = (*v)->point();
+					out.push_back({ float(p[0]), float(p[1]) });
+				}
+
+				//Closed constraints end on their first vertex.
+				if (out.size() > 1 && out.front().x == out.back().x && out.front().y == out.back().y)
+					out.pop_back();
+			}
+		}
+	}
+
+	//Simplifies the window as an open polyline. Unless this is the last window
+	//only the vertices before the look-back region are emitted, and the window
+	//restarts at the last emitted vertex so the next window sees the region
+	//again with more context. The first vertex has already been emitted.
+	void ProcessWindow(PolylineStream& s, bool last)
+	{
+		int count = int(s.window.size());
+		if (count < 2)
+		{
+			if (last) s.window.clear();
+			return;
+		}
+
+		CT ct;
+		CT::Constraint_id id = ct.insert_constraint(s.window.begin(), s.window.end());
+
+		if (s.method == SCALED_SQUARE_DIST)
+			PS::simplify(ct, PS::Scaled_squared_distance_cost(), Stop(s.threshold));
+		else
+			PS::simplify(ct, PS::Squared_distance_cost(), Stop(s.threshold));
+
+		//Position of each kept vertex in the window. Vertices added where the
+		//polyline crosses itself sit between the window points around them.
+		vector<Point> kept;
+		vector<double> position;
+
+		int matched = 0;
+		for (auto v = ct.vertices_in_constraint_begin(id); v != ct.vertices_in_constraint_end(id); ++v)
+		{
+			const Point& p = (*v)->point();
+
+			int j = (kept.size() == 0) ? 0 : matched + 1;
+			while (j < count && s.window[j] != p) j++;
+
+			if (j < count)
+			{
+				matched = j;
+				position.push_back(j);
+			}
+			else
+				position.push_back(matched + 0.5);
+
+			kept.push_back(p);
+		}
+
+		//Every point of the window was the same point.
+		if (kept.size() < 2)
+		{
+			s.window.erase(s.window.begin(), s.window.end() - 1);
+			if (last) s.window.clear();
+			return;
+		}
+
+		int cut = last ? count : count - (std::max)(1, s.windowSize / 4);
+
+		int end = 1;
+		while (end < int(kept.size()) && position[end] < cut) end++;
+
+		//Always advance even if the whole region before the cut was removed.
+		if (end == 1) end = 2;
+		end = (std::min)(end, int(kept.size()));
+
+		for (int i = 1; i < end; i++)
+			s.output.push_back({ float(kept[i][0]), float(kept[i][1]) });
+
+		if (last)
+		{
+			s.window.clear();
+			return;
+		}
+
+		const Point& restart = kept[end - 1];
+		int next = int(position[end - 1]) + 1;
+
+		vector<Point> window;
+		window.reserve(s.windowSize);
+		window.push_back(restart);
+		window.insert(window.end(), s.window.begin() + next, s.window.end());
+		s.window.swap(window);
+	}
 
 	CGALWRAPPERAPI void CALLCON Simplify2_LoadPoints2f(const Point2f* inPoints, int inSize)
 	{
@@ -29,12 +355,24 @@ namespace PolygonSimplify2
 	{
 		polygon.clear();
 		simplified.clear();
+		removalOrder.indices.clear();
+		removalOrder.costs.clear();
+		removalOrder.offeredCosts.clear();
+		removalOrder.offeredRemovals.clear();
+		levelCounts.clear();
+		batchOutput.Clear();
+		stream.window.clear();
+		stream.output.clear();
 	}
 
 	CGALWRAPPERAPI void CALLCON Simplify2_Release()
 	{
 		polygon = Polygon();
 		simplified = Polygon();
+		removalOrder = RemovalOrder();
+		levelCounts.resize(0);
+		batchOutput.Release();
+		stream = PolylineStream();
 	}
 
 	CGALWRAPPERAPI int CALLCON Simplify2_SquareDistCostSimplify(float threshold)
@@ -63,11 +401,256 @@ namespace PolygonSimplify2
 		}
 	}
 
+	//Stops once the cheapest removal left costs more than the threshold.
+	CGALWRAPPERAPI int CALLCON Simplify2_CostThresholdSimplify(float threshold, int method)
+	{
+		try
+		{
+			return SimplifyLoaded(method, PS::Stop_above_cost_threshold(threshold));
+		}
+		catch (...)
+		{
+			return 0;
+		}
+	}
+
+	//Stops once no more than count vertices are left.
+	CGALWRAPPERAPI int CALLCON Simplify2_CountThresholdSimplify(int count, int method)
+	{
+		try
+		{
+			return SimplifyLoaded(method, PS::Stop_below_count_threshold(size_t((std::max)(0, count))));
+		}
+		catch (...)
+		{
+			return 0;
+		}
+	}
+
 	CGALWRAPPERAPI Point2f CALLCON Simplify2_GetSimplifiedPoint2f(int i)
 	{
 		Point p = simplified[i];
 		return { float(p[0]) , float(p[1]) };
 	}
 
+	//Runs the simplification to completion once on the loaded polygon.
+	//Returns the number of vertices that can be removed.
+	CGALWRAPPERAPI int CALLCON Simplify2_ProgressiveSimplify(int method)
+	{
+		try
+		{
+			RecordRemovalOrder(polygon, method, removalOrder);
+			return int(removalOrder.indices.size());
+		}
+		catch (...)
+		{
+			removalOrder.indices.clear();
+			removalOrder.costs.clear();
+			removalOrder.offeredCosts.clear();
+			removalOrder.offeredRemovals.clear();
+			return 0;
+		}
+	}
+
+	//The level with k removals is the loaded polygon without the first k
+	//vertices of the removal order, so this one buffer holds every level.
+	CGALWRAPPERAPI void CALLCON Simplify2_GetRemovalOrder(int* outIndices, float* outCosts)
+	{
+		for (size_t i = 0; i < removalOrder.indices.size(); i++)
+		{
+			outIndices[i] = removalOrder.indices[i];
+			outCosts[i] = float(removalOrder.costs[i]);
+		}
+	}
+
+	//Number of vertices the simplification was offered, blocked ones included.
+	CGALWRAPPERAPI int CALLCON Simplify2_GetOfferCount()
+	{
+		return int(removalOrder.offeredCosts.size());
+	}
+
+	//Highest cost offered so far and the removals made before each offer,
+	//so a cost threshold stops where the simplification itself would.
+	CGALWRAPPERAPI void CALLCON Simplify2_GetOffers(float* outCosts, int* outRemovals)
+	{
+		for (size_t i = 0; i < removalOrder.offeredCosts.size(); i++)
+		{
+			outCosts[i] = float(removalOrder.offeredCosts[i]);
+			outRemovals[i] = removalOrder.offeredRemovals[i];
+		}
+	}
+
+	//Simplifies polygons with holes in the flat buffer layout, with the
+	//threshold applied per group of polygons that touch.
+	CGALWRAPPERAPI CGALResult CALLCON Simplify2_BatchSimplify2f(const Point2f* inPoints, const int* inRingSizes, const int* inPolygonRings, int numPolygons, float threshold, int method)
+	{
+		try
+		{
+			batchOutput.Clear();
+
+			PolygonBuffer2f input;
+			input.Load(inPoints, inRingSizes, inPolygonRings, numPolygons);
+
+			vector<vector<int>> components;
+			FindComponents(input, components);
+
+			vector<vector<Point2f>> rings(input.ringSizes.size());
+
+			Utility::ParallelFor(int(components.size()), [&](int i)
+			{
+				SimplifyComponent(input, components[i], threshold, method, rings);
+			});
+
+			for (int i = 0; i < input.NumPolygons(); i++)
+			{
+				int ring = input.ringOffsets[i];
+
+				batchOutput.ringOffsets.push_back(int(batchOutput.ringSizes.size()));
+				batchOutput.polygonRings.push_back(input.polygonRings[i]);
+
+				for (int j = 0; j < input.polygonRings[i]; j++)
+				{
+					const vector<Point2f>& points = rings[ring + j];
+
+					batchOutput.pointOffsets.push_back(int(batchOutput.points.size()));
+					batchOutput.ringSizes.push_back(int(points.size()));
+					batchOutput.points.insert(batchOutput.points.end(), points.begin(), points.end());
+				}
+			}
+
+			return CGAL_SUCCESS;
+		}
+		catch (...)
+		{
+			batchOutput.Clear();
+			return CGAL_ERROR;
+		}
+	}
+
+	CGALWRAPPERAPI PolygonBufferDescriptor CALLCON Simplify2_GetBatchDescriptor()
+	{
+		return batchOutput.Descriptor();
+	}
+
+	CGALWRAPPERAPI void CALLCON Simplify2_GetBatch2f(Point2f* outPoints, int* outRingSizes, int* outPolygonRings)
+	{
+		batchOutput.CopyTo(outPoints, outRingSizes, outPolygonRings);
+	}
+
+	//Starts a new open polyline. The threshold is the count ratio applied to each
+	//window and the last quarter of each window is held back as look-back.
+	CGALWRAPPERAPI void CALLCON Simplify2_BeginStream(int method, float threshold, int windowSize)
+	{
+		stream.method = method;
+		stream.threshold = threshold;
+		stream.windowSize = (std::max)(8, windowSize);
+		stream.started = false;
+
+		stream.window.clear();
+		stream.window.reserve(stream.windowSize);
+		stream.output.clear();
+	}
+
+	//Pushes the next points of the polyline. Returns the number of
+	//simplified points ready to be collected.
+	CGALWRAPPERAPI int CALLCON Simplify2_PushStream2f(const Point2f* inPoints, int inSize)
+	{
+		try
+		{
+			for (int i = 0; i < inSize; i++)
+			{
+				if (!stream.started)
+				{
+					stream.output.push_back(inPoints[i]);
+					stream.started = true;
+				}
+
+				stream.window.push_back(Point(inPoints[i].x, inPoints[i].y));
+
+				if (int(stream.window.size()) >= stream.windowSize)
+					ProcessWindow(stream, false);
+			}
+
+			return int(stream.output.size());
+		}
+		catch (...)
+		{
+			return -1;
+		}
+	}
+
+	//Simplifies what is left of the polyline. Returns the number of
+	//simplified points ready to be collected.
+	CGALWRAPPERAPI int CALLCON Simplify2_EndStream()
+	{
+		try
+		{
+			ProcessWindow(stream, true);
+			stream.started = false;
+
+			return int(stream.output.size());
+		}
+		catch (...)
+		{
+			stream.window.clear();
+			return -1;
+		}
+	}
+
+	//Copies out the simplified points ready to be collected and forgets them.
+	CGALWRAPPERAPI void CALLCON Simplify2_GetStream2f(Point2f* outPoints)
+	{
+		std::copy(stream.output.begin(), stream.output.end(), outPoints);
+		stream.output.clear();
+	}
+
+	//Simplifies the loaded polygon once and evaluates every threshold against
+	//the removal order. Writes the vertex count of each result.
+	CGALWRAPPERAPI CGALResult CALLCON Simplify2_MultiThresholdSimplify(const float* thresholds, int numThresholds, int criterion, int method, int* outCounts)
+	{
+		try
+		{
+			levelCounts.clear();
+			RecordRemovalOrder(polygon, method, removalOrder);
+
+			int size = int(polygon.size());
+			for (int i = 0; i < numThresholds; i++)
+			{
+				int removals = RemovalsBeforeStop(removalOrder, size, criterion, thresholds[i]);
+				levelCounts.push_back(removals);
+				outCounts[i] = size - removals;
+			}
+
+			return CGAL_SUCCESS;
+		}
+		catch (...)
+		{
+			levelCounts.clear();
+			return CGAL_ERROR;
+		}
+	}
+
+	//Copies the results of the last multi threshold simplification back to back.
+	CGALWRAPPERAPI void CALLCON Simplify2_GetMultiThreshold2f(Point2f* outPoints)
+	{
+		int size = int(polygon.size());
+
+		//Position of each vertex in the removal order.
+		vector<int> removedAt(size, INT_MAX);
+		for (size_t i = 0; i < removalOrder.indices.size(); i++)
+			removedAt[removalOrder.indices[i]] = int(i);
+
+		int n = 0;
+		for (int removals : levelCounts)
+		{
+			for (int i = 0; i < size; i++)
+			{
+				if (removedAt[i] < removals) continue;
+
+				Point p = polygon[i];
+				outPoints[n++] = { float(p[0]), float(p[1]) };
+			}
+		}
+	}
 
 }
\ No newline at end of file
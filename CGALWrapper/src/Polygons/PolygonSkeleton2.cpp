@@ -1,6 +1,9 @@
 
 #include "stdafx.h"
 #include "Polygons/PolygonSkeleton2.h"
+#include "Primatives/PolygonBuffer2.h"
+#include "Utility/ParallelFor.h"
+#include "Utility/PolygonDomains.h"
 
 #include<boost/shared_ptr.hpp>
 #include<CGAL/Exact_predicates_inexact_constructions_kernel.h>
@@ -9,8 +12,13 @@
 #include<CGAL/create_straight_skeleton_from_polygon_with_holes_2.h>
 #include<CGAL/create_offset_polygons_2.h>
 #include<CGAL/create_offset_polygons_from_polygon_with_holes_2.h>
+#include<CGAL/arrange_offset_polygons_2.h>
 
 #include <iostream>
+#include <stdexcept>
+#include <list>
+#include <cmath>
+#include <algorithm>
 
 using namespace std;
 
@@ -25,68 +33,214 @@ namespace PolygonSkeleton2
 	typedef boost::shared_ptr<Ss> SsPtr;
 	typedef boost::shared_ptr<Polygon> PolygonPtr;
 	typedef std::vector<PolygonPtr> PolygonPtrVector;
+	typedef boost::shared_ptr<PolygonWithHoles> PolygonWithHolesPtr;
+	typedef std::vector<PolygonWithHolesPtr> PolygonWithHolesPtrVector;
 
 	typedef Ss::Vertex_handle Vertex;
 	typedef Ss::Halfedge_handle HalfEdge;
 
+	typedef Utility::DomainTriangulation<K>::CDT CDT;
+
+	//Skeleton as flat arrays. Edges hold one entry per pair of halfedges and
+	//the connections refer to halfedges.
+	struct SkeletonBuffer
+	{
+		vector<Point> points;
+		vector<float> times;
+		vector<unsigned char> contour;
+		vector<EdgeIndex> edges;
+		vector<EdgeConnection> edgeConnections;
+
+		void Clear()
+		{
+			points.clear();
+			times.clear();
+			contour.clear();
+			edges.clear();
+			edgeConnections.clear();
+		}
+
+		void Release()
+		{
+			points.resize(0);
+			times.resize(0);
+			contour.resize(0);
+			edges.resize(0);
+			edgeConnections.resize(0);
+		}
+
+		MeshDescriptor Descriptor() const
+		{
+			MeshDescriptor descriptor;
+			descriptor.vertices = int(points.size());
+			descriptor.edges = int(edges.size());
+			descriptor.faces = 0;
+
+			return descriptor;
+		}
+
+		//Indices are kept local to the appended skeleton.
+		void Append(const SkeletonBuffer& buffer)
+		{
+			points.insert(points.end(), buffer.points.begin(), buffer.points.end());
+			times.insert(times.end(), buffer.times.begin(), buffer.times.end());
+			contour.insert(contour.end(), buffer.contour.begin(), buffer.contour.end());
+			edges.insert(edges.end(), buffer.edges.begin(), buffer.edges.end());
+			edgeConnections.insert(edgeConnections.end(), buffer.edgeConnections.begin(), buffer.edgeConnections.end());
+		}
+	};
+
+	//Skeletons of one polygon with holes, kept until the polygon changes. The
+	//exterior of a polygon with holes is the outside of its outer boundary and
+	//the inside of each hole, so it is covered by the exterior skeleton of the
+	//boundary and the interior skeleton of each reversed hole.
+	struct Skeletons
+	{
+		SsPtr interior, exterior;
+		vector<SsPtr> holes;
+		double exteriorMaxOffset;
+
+		Skeletons() : exteriorMaxOffset(0) {}
+
+		void Reset()
+		{
+			interior.reset();
+			exterior.reset();
+			holes.clear();
+			exteriorMaxOffset = 0;
+		}
+
+		SsPtr Interior(const PolygonWithHoles& pwh)
+		{
+			if (interior == nullptr)
+				interior = CGAL::create_interior_straight_skeleton_2(pwh);
+
+			if (interior == nullptr)
+				throw std::runtime_error("Failed to create interior skeleton.");
+
+			return interior;
+		}
+
+		//The exterior skeleton is built inside a frame placed from maxOffset, so it
+		//is reused only for the same maxOffset unless any larger one will do.
+		void Exterior(const PolygonWithHoles& pwh, double maxOffset, bool allowLarger)
+		{
+			bool reuse = exterior != nullptr && (exteriorMaxOffset == maxOffset || (allowLarger && exteriorMaxOffset > maxOffset));
+
+			if (!reuse)
+			{
+				exterior = CGAL::create_exterior_straight_skeleton_2(maxOffset, pwh.outer_boundary());
+				exteriorMaxOffset = maxOffset;
+			}
+
+			if (exterior == nullptr)
+				throw std::runtime_error("Failed to create exterior skeleton.");
+
+			if (holes.size() == pwh.number_of_holes()) return;
+
+			holes.clear();
+			for (auto hole = pwh.holes_begin(); hole != pwh.holes_end(); ++hole)
+			{
+				Polygon reversed = *hole;
+				reversed.reverse_orientation();
+
+				SsPtr skeleton = CGAL::create_interior_straight_skeleton_2(reversed);
+				if (skeleton == nullptr)
+					throw std::runtime_error("Failed to create hole skeleton.");
+
+				holes.push_back(skeleton);
+			}
+		}
+	};
+
 	PolygonWithHoles polygon;
 
-	vector<Point> points;
-	vector<EdgeIndex> edges;
-	vector<EdgeConnection> edgeConnections;
+	SkeletonBuffer skeleton;
 	vector<PolygonPtr> polygons;
 
-	CGALWRAPPERAPI void CALLCON Skeleton2_LoadPoints2f(const Point2f* inPoints, int inSize)
-	{
-		vector<Point> points = ToPointArray2<Point, Point2f>(inPoints, inSize);
-		polygon = PolygonWithHoles(Polygon(points.begin(), points.end()));
-	}
+	Skeletons skeletons;
 
-	CGALWRAPPERAPI void CALLCON Skeleton2_AddHole2f(const Point2f* inPoints, int inSize)
-	{
-		vector<Point> points = ToPointArray2<Point, Point2f>(inPoints, inSize);
-		polygon.add_hole(Polygon(points.begin(), points.end()));
-	}
+	PolygonBuffer2f offsetPolygons;
+	vector<int> offsetIndices;
 
-	CGALWRAPPERAPI void CALLCON Skeleton2_Clear()
+	vector<int> vertexOffsets, edgeOffsets, connectionOffsets, sourceOffsets;
+
+	//Offset polygons of one distance arranged into polygons with holes. The
+	//first exterior offset is of the frame so it is dropped, and the rest are
+	//the holes of the frame so they are reversed.
+	PolygonWithHolesPtrVector CreateOffset(const Ss& ss, double offset, bool exterior)
 	{
-		polygon.clear();
-		points.clear();
-		edges.clear();
-		edgeConnections.clear();
-		polygons.clear();
+		PolygonPtrVector rings = CGAL::create_offset_polygons_2<Polygon>(offset, ss);
+
+		if (exterior && rings.size() > 0)
+		{
+			rings.erase(rings.begin());
+
+			for (auto& ring : rings)
+				ring->reverse_orientation();
+		}
+
+		return CGAL::arrange_offset_polygons_2(rings);
 	}
 
-	CGALWRAPPERAPI void CALLCON Skeleton2_Release()
+	//Holes shrink as the outer boundary grows. What is left of each hole is
+	//added to the grown polygon that contains it.
+	PolygonWithHolesPtrVector CreateExteriorOffset(const Skeletons& s, double offset)
 	{
-		polygon = PolygonWithHoles();
-		points.resize(0);
-		edges.resize(0);
-		edgeConnections.resize(0);
-		polygons.resize(0);
+		PolygonWithHolesPtrVector result = CreateOffset(*s.exterior, offset, true);
+
+		for (auto& hole : s.holes)
+		{
+			PolygonPtrVector rings = CGAL::create_offset_polygons_2<Polygon>(offset, *hole);
+
+			for (auto& ring : rings)
+			{
+				ring->reverse_orientation();
+
+				for (auto& pwh : result)
+				{
+					if (pwh->outer_boundary().bounded_side((*ring)[0]) != CGAL::ON_BOUNDED_SIDE) continue;
+
+					pwh->add_hole(*ring);
+					break;
+				}
+			}
+		}
+
+		return result;
 	}
 
-	MeshDescriptor ConvertFromHalfEdge(SsPtr iss, BOOL includeBorder)
+	//Vertex and halfedge ids are handed out in sequence by the skeleton builder,
+	//so plain arrays indexed by id replace maps. Appends to the buffer with
+	//indices following on from what it already holds.
+	void ConvertFromHalfEdge(SsPtr iss, BOOL includeBorder, SkeletonBuffer& out)
 	{
-		points.clear();
-		edges.clear();
-		edgeConnections.clear();
+		int maxVertexId = -1, maxEdgeId = -1;
 
-		map<int, int> edgeIndex;
-		map<int, int> vertIndex;
+		for (Vertex v = iss->vertices_begin(); v != iss->vertices_end(); ++v)
+			maxVertexId = (std::max)(maxVertexId, v->id());
 
-		int index = 0;
+		for (HalfEdge edge = iss->halfedges_begin(); edge != iss->halfedges_end(); ++edge)
+			maxEdgeId = (std::max)(maxEdgeId, edge->id());
+
+		const int UNSET = -2;
+		vector<int> vertIndex(maxVertexId + 1, -1);
+		vector<int> edgeIndex(maxEdgeId + 1, UNSET);
+
+		int index = int(out.points.size());
 		for (Vertex v = iss->vertices_begin(); v != iss->vertices_end(); ++v)
 		{
-			vertIndex.insert(pair<int, int>(v->id(), index++));
-			points.push_back(v->point());
+			vertIndex[v->id()] = index++;
+			out.points.push_back(v->point());
+			out.times.push_back(float(v->time()));
+			out.contour.push_back(v->is_contour() ? 1 : 0);
 		}
 
-		index = 0;
+		index = 2 * int(out.edges.size());
 		for (HalfEdge edge = iss->halfedges_begin(); edge != iss->halfedges_end(); ++edge)
 		{
 			if (edge->is_border()) continue;
-			if (edgeIndex.find(edge->id()) != edgeIndex.end()) continue;
+			if (edgeIndex[edge->id()] != UNSET) continue;
 
 			HalfEdge opp = edge->opposite();
 			Vertex v0 = edge->vertex();
@@ -94,21 +248,24 @@ namespace PolygonSkeleton2
 
 			if (!includeBorder && v0->is_contour() && v1->is_contour())
 			{
-				edgeIndex.insert(pair<int, int>(edge->id(), -1));
-				edgeIndex.insert(pair<int, int>(opp->id(), -1));
+				edgeIndex[edge->id()] = -1;
+				edgeIndex[opp->id()] = -1;
 			}
 			else
 			{
 				int i0 = vertIndex[v0->id()];
 				int i1 = vertIndex[v1->id()];
 
-				edges.push_back({ i0, i1 });
-				edgeIndex.insert(pair<int, int>(edge->id(), index++));
-				edgeIndex.insert(pair<int, int>(opp->id(), index++));
-	
+				out.edges.push_back({ i0, i1 });
+				edgeIndex[edge->id()] = index++;
+				edgeIndex[opp->id()] = index++;
 			}
 		}
 
+		//Every halfedge is reached through itself or its opposite.
+		for (auto& id : edgeIndex)
+			if (id == UNSET) id = -1;
+
 		for (HalfEdge edge = iss->halfedges_begin(); edge != iss->halfedges_end(); ++edge)
 		{
 			int id = edgeIndex[edge->id()];
@@ -122,25 +279,260 @@ namespace PolygonSkeleton2
 				con.next = edgeIndex[edge->next()->id()];
 				con.opposite = edgeIndex[edge->opposite()->id()];
 
-				edgeConnections.push_back(con);
+				out.edgeConnections.push_back(con);
+			}
+
+		}
+	}
+
+	void ConvertExterior(const Skeletons& s, BOOL includeBorder, SkeletonBuffer& out)
+	{
+		ConvertFromHalfEdge(s.exterior, includeBorder, out);
+
+		for (auto& hole : s.holes)
+			ConvertFromHalfEdge(hole, includeBorder, out);
+	}
+
+	//Adds the ring as constraints between samples no more than tolerance apart.
+	void InsertSampledRing(CDT& cdt, const Polygon& ring, double tolerance)
+	{
+		vector<Point> samples;
+		int n = int(ring.size());
+
+		for (int i = 0; i < n; i++)
+		{
+			const Point& a = ring[i];
+			const Point& b = ring[(i + 1) % n];
+
+			double length = std::sqrt(CGAL::squared_distance(a, b));
+			int steps = (std::max)(1, int(std::ceil(length / tolerance)));
+
+			for (int j = 0; j < steps; j++)
+			{
+				double t = double(j) / steps;
+				samples.push_back(Point(a.x() + (b.x() - a.x()) * t, a.y() + (b.y() - a.y()) * t));
+			}
+		}
+
+		cdt.insert_constraint(samples.begin(), samples.end(), true);
+	}
+
+	//Appends an undirected graph in the halfedge layout of ConvertFromHalfEdge.
+	//Halfedge 2i ends at the first vertex of edge i and 2i + 1 at the second.
+	//Next is the first outgoing halfedge clockwise from the opposite, which
+	//keeps each face on the left.
+	void ConvertFromGraph(const vector<Point>& vertices, const vector<double>& radii, const vector<pair<int, int>>& graph, SkeletonBuffer& out)
+	{
+		int vertexBase = int(out.points.size());
+		int edgeBase = 2 * int(out.edges.size());
+		int numVertices = int(vertices.size());
+		int numHalfEdges = 2 * int(graph.size());
+
+		for (int i = 0; i < numVertices; i++)
+		{
+			out.points.push_back(vertices[i]);
+			out.times.push_back(float(radii[i]));
+			out.contour.push_back(0);
+		}
+
+		vector<vector<int>> outgoing(numVertices);
+		vector<int> target(numHalfEdges);
+
+		for (int i = 0; i < int(graph.size()); i++)
+		{
+			int a = graph[i].first, b = graph[i].second;
+			out.edges.push_back({ vertexBase + a, vertexBase + b });
+
+			target[2 * i] = a;
+			target[2 * i + 1] = b;
+			outgoing[b].push_back(2 * i);
+			outgoing[a].push_back(2 * i + 1);
+		}
+
+		vector<int> slot(numHalfEdges);
+		for (int v = 0; v < numVertices; v++)
+		{
+			auto angle = [&](int h)
+			{
+				const Point& p = vertices[v];
+				const Point& q = vertices[target[h]];
+				return std::atan2(q.y() - p.y(), q.x() - p.x());
+			};
+
+			sort(outgoing[v].begin(), outgoing[v].end(), [&](int h0, int h1) { return angle(h0) < angle(h1); });
+
+			for (int k = 0; k < int(outgoing[v].size()); k++)
+				slot[outgoing[v][k]] = k;
+		}
+
+		vector<int> next(numHalfEdges), prev(numHalfEdges);
+		for (int h = 0; h < numHalfEdges; h++)
+		{
+			int opp = h ^ 1;
+			const vector<int>& around = outgoing[target[h]];
+			int count = int(around.size());
+
+			next[h] = around[(slot[opp] + count - 1) % count];
+			prev[next[h]] = h;
+		}
+
+		for (int h = 0; h < numHalfEdges; h++)
+			out.edgeConnections.push_back({ edgeBase + h, edgeBase + prev[h], edgeBase + next[h], edgeBase + (h ^ 1) });
+	}
+
+	//Approximates the medial axis from a Delaunay triangulation of boundary
+	//samples no more than tolerance apart. The circumcenters of the inside
+	//triangles are the axis vertices. Neighbouring triangles are joined only
+	//if the samples either side of their shared edge are at least pruneLength
+	//apart, which drops the short branches that boundary noise creates.
+	void ApproximateMedialAxis(const PolygonWithHoles& pwh, double tolerance, double pruneLength, SkeletonBuffer& out)
+	{
+		if (tolerance <= 0)
+			throw std::invalid_argument("Tolerance must be positive.");
+
+		CDT cdt;
+		InsertSampledRing(cdt, pwh.outer_boundary(), tolerance);
+
+		for (auto hole = pwh.holes_begin(); hole != pwh.holes_end(); ++hole)
+			InsertSampledRing(cdt, *hole, tolerance);
+
+		Utility::MarkDomains(cdt);
+
+		vector<Point> centers;
+		vector<double> radii;
+
+		for (auto face = cdt.finite_faces_begin(); face != cdt.finite_faces_end(); ++face)
+		{
+			if (!face->info().InDomain()) continue;
+
+			face->info().id = int(centers.size());
+
+			Point center = CGAL::circumcenter(face->vertex(0)->point(), face->vertex(1)->point(), face->vertex(2)->point());
+			centers.push_back(center);
+			radii.push_back(std::sqrt(CGAL::squared_distance(center, face->vertex(0)->point())));
+		}
+
+		//Triangles on a common circle share a circumcenter and are merged.
+		vector<int> parent(centers.size());
+		for (size_t i = 0; i < parent.size(); i++)
+			parent[i] = int(i);
+
+		double merge = 1e-6 * tolerance;
+		vector<pair<int, int>> links;
+
+		for (auto e = cdt.finite_edges_begin(); e != cdt.finite_edges_end(); ++e)
+		{
+			CDT::Face_handle f = e->first;
+			CDT::Face_handle n = f->neighbor(e->second);
+
+			if (!f->info().InDomain() || !n->info().InDomain()) continue;
+			if (cdt.is_constrained(*e)) continue;
+
+			int a = f->info().id, b = n->info().id;
+
+			if (CGAL::squared_distance(centers[a], centers[b]) <= merge * merge)
+			{
+				int ra = Utility::FindRoot(parent, a), rb = Utility::FindRoot(parent, b);
+				if (ra != rb) parent[ra] = rb;
+				continue;
 			}
 
+			const Point& p = f->vertex(f->cw(e->second))->point();
+			const Point& q = f->vertex(f->ccw(e->second))->point();
+
+			if (CGAL::squared_distance(p, q) < pruneLength * pruneLength) continue;
+
+			links.push_back(pair<int, int>(a, b));
 		}
 
-		MeshDescriptor descriptor;
-		descriptor.vertices = int(points.size());
-		descriptor.edges = int(edges.size());
-		descriptor.faces = 0;
+		vector<pair<int, int>> roots;
+		for (auto& link : links)
+		{
+			int a = Utility::FindRoot(parent, link.first), b = Utility::FindRoot(parent, link.second);
+			if (a == b) continue;
+
+			roots.push_back(pair<int, int>((std::min)(a, b), (std::max)(a, b)));
+		}
+
+		sort(roots.begin(), roots.end());
+		roots.erase(unique(roots.begin(), roots.end()), roots.end());
+
+		vector<int> index(centers.size(), -1);
+		vector<Point> vertices;
+		vector<double> vertexRadii;
+		vector<pair<int, int>> graph;
+
+		for (auto& root : roots)
+		{
+			int ends[2] = { root.first, root.second };
+
+			for (int& end : ends)
+			{
+				if (index[end] == -1)
+				{
+					index[end] = int(vertices.size());
+					vertices.push_back(centers[end]);
+					vertexRadii.push_back(radii[end]);
+				}
+
+				end = index[end];
+			}
+
+			graph.push_back(pair<int, int>(ends[0], ends[1]));
+		}
+
+		ConvertFromGraph(vertices, vertexRadii, graph, out);
+	}
+
+	CGALWRAPPERAPI void CALLCON Skeleton2_LoadPoints2f(const Point2f* inPoints, int inSize)
+	{
+		vector<Point> points = ToPointArray2<Point, Point2f>(inPoints, inSize);
+		polygon = PolygonWithHoles(Polygon(points.begin(), points.end()));
+		skeletons.Reset();
+	}
+
+	CGALWRAPPERAPI void CALLCON Skeleton2_AddHole2f(const Point2f* inPoints, int inSize)
+	{
+		vector<Point> points = ToPointArray2<Point, Point2f>(inPoints, inSize);
+		polygon.add_hole(Polygon(points.begin(), points.end()));
+		skeletons.Reset();
+	}
+
+	CGALWRAPPERAPI void CALLCON Skeleton2_Clear()
+	{
+		polygon.clear();
+		skeleton.Clear();
+		polygons.clear();
+		skeletons.Reset();
+		offsetPolygons.Clear();
+		offsetIndices.clear();
+		vertexOffsets.clear();
+		edgeOffsets.clear();
+		connectionOffsets.clear();
+		sourceOffsets.clear();
+	}
 
-		return descriptor;
+	CGALWRAPPERAPI void CALLCON Skeleton2_Release()
+	{
+		polygon = PolygonWithHoles();
+		skeleton.Release();
+		polygons.resize(0);
+		skeletons = Skeletons();
+		offsetPolygons.Release();
+		offsetIndices.resize(0);
+		vertexOffsets.resize(0);
+		edgeOffsets.resize(0);
+		connectionOffsets.resize(0);
+		sourceOffsets.resize(0);
 	}
 
 	CGALWRAPPERAPI CGALResult CALLCON Skeleton2_CreateInteriorSkeleton(BOOL includeBorder, MeshDescriptor& descriptor)
 	{
 		try
 		{
-			SsPtr iss = CGAL::create_interior_straight_skeleton_2(polygon);
-			descriptor = ConvertFromHalfEdge(iss, includeBorder);
+			skeleton.Clear();
+			ConvertFromHalfEdge(skeletons.Interior(polygon), includeBorder, skeleton);
+			descriptor = skeleton.Descriptor();
 			return CGAL_SUCCESS;
 		}
 		catch (...)
@@ -149,16 +541,40 @@ namespace PolygonSkeleton2
 		}
 	}
 
+	//The skeletons of any holes follow the skeleton of the outer boundary.
 	CGALWRAPPERAPI CGALResult CALLCON Skeleton2_CreateExteriorSkeleton(double maxOffset, BOOL includeBorder, MeshDescriptor& descriptor)
 	{
 		try
 		{
-			SsPtr iss = CGAL::create_exterior_straight_skeleton_2(maxOffset, polygon.outer_boundary());
-			descriptor = ConvertFromHalfEdge(iss, includeBorder);
+			skeleton.Clear();
+			skeletons.Exterior(polygon, maxOffset, false);
+			ConvertExterior(skeletons, includeBorder, skeleton);
+			descriptor = skeleton.Descriptor();
+			return CGAL_SUCCESS;
+		}
+		catch (...)
+		{
+			return CGAL_ERROR;
+		}
+	}
+
+	//Approximate medial axis of the loaded polygon for inputs too large or noisy
+	//for the exact skeleton. Times are the distance to the boundary. A prune
+	//length of zero or less uses twice the tolerance.
+	CGALWRAPPERAPI CGALResult CALLCON Skeleton2_CreateApproximateMedialAxis(double tolerance, double pruneLength, MeshDescriptor& descriptor)
+	{
+		try
+		{
+			if (pruneLength <= 0) pruneLength = 2 * tolerance;
+
+			skeleton.Clear();
+			ApproximateMedialAxis(polygon, tolerance, pruneLength, skeleton);
+			descriptor = skeleton.Descriptor();
 			return CGAL_SUCCESS;
 		}
 		catch (...)
 		{
+			skeleton.Clear();
 			return CGAL_ERROR;
 		}
 	}
@@ -167,8 +583,8 @@ namespace PolygonSkeleton2
 	{
 		try
 		{
-			polygons = CGAL::create_interior_skeleton_and_offset_polygons_2(offset, polygon);
-			return polygons.size();
+			polygons = CGAL::create_offset_polygons_2<Polygon>(offset, *skeletons.Interior(polygon));
+			return int(polygons.size());
 		}
 		catch (...)
 		{
@@ -178,23 +594,46 @@ namespace PolygonSkeleton2
 
 	CGALWRAPPERAPI Point2f CALLCON Skeleton2_GetSkeletonPoint2f(int i)
 	{
-		Point p = points[i];
+		Point p = skeleton.points[i];
 		return{ float(p[0]) , float(p[1]) };
 	}
 
 	CGALWRAPPERAPI EdgeIndex CALLCON Skeleton2_GetSkeletonEdge(int i)
 	{
-		return edges[i];
+		return skeleton.edges[i];
 	}
 
 	CGALWRAPPERAPI int CALLCON Skeleton2_NumEdgeConnection()
 	{
-		return int(edgeConnections.size());
+		return int(skeleton.edgeConnections.size());
 	}
 
 	CGALWRAPPERAPI EdgeConnection CALLCON Skeleton2_GetEdgeConnection(int i)
 	{
-		return edgeConnections[i];
+		return skeleton.edgeConnections[i];
+	}
+
+	//Copies out the whole skeleton. The number of edge connections is given by
+	//Skeleton2_NumEdgeConnection. Any buffer may be null to skip it.
+	CGALWRAPPERAPI void CALLCON Skeleton2_GetSkeleton2f(Point2f* outPoints, EdgeIndex* outEdges, EdgeConnection* outConnections, float* outTimes, unsigned char* outContour)
+	{
+		if (outPoints != nullptr)
+		{
+			for (size_t i = 0; i < skeleton.points.size(); i++)
+				outPoints[i] = { float(skeleton.points[i][0]), float(skeleton.points[i][1]) };
+		}
+
+		if (outEdges != nullptr)
+			std::copy(skeleton.edges.begin(), skeleton.edges.end(), outEdges);
+
+		if (outConnections != nullptr)
+			std::copy(skeleton.edgeConnections.begin(), skeleton.edgeConnections.end(), outConnections);
+
+		if (outTimes != nullptr)
+			std::copy(skeleton.times.begin(), skeleton.times.end(), outTimes);
+
+		if (outContour != nullptr)
+			std::copy(skeleton.contour.begin(), skeleton.contour.end(), outContour);
 	}
 
 	CGALWRAPPERAPI int CALLCON Skeleton2_NumPolygonPoints(int polygonIndex)
@@ -208,4 +647,221 @@ namespace PolygonSkeleton2
 		return{ float(p[0]) , float(p[1]) };
 	}
 
+	//Creates the offset polygons for every distance from one skeleton, which is
+	//kept for later calls until the polygon changes.
+	CGALWRAPPERAPI CGALResult CALLCON Skeleton2_CreateOffsets(const double* inOffsets, int numOffsets, BOOL exterior, PolygonBufferDescriptor& descriptor)
+	{
+		try
+		{
+			offsetPolygons.Clear();
+			offsetIndices.clear();
+
+			if (exterior)
+			{
+				double maxOffset = 0;
+				for (int i = 0; i < numOffsets; i++)
+					maxOffset = (std::max)(maxOffset, inOffsets[i]);
+
+				skeletons.Exterior(polygon, maxOffset, true);
+			}
+			else
+				skeletons.Interior(polygon);
+
+			vector<PolygonWithHolesPtrVector> results(numOffsets);
+
+			Utility::ParallelFor(numOffsets, [&](int i)
+			{
+				if (exterior)
+					results[i] = CreateExteriorOffset(skeletons, inOffsets[i]);
+				else
+					results[i] = CreateOffset(*skeletons.interior, inOffsets[i], false);
+			});
+
+			for (int i = 0; i < numOffsets; i++)
+			{
+				for (auto& result : results[i])
+				{
+					offsetPolygons.AddPolygonWithHoles(*result);
+					offsetIndices.push_back(i);
+				}
+			}
+
+			descriptor = offsetPolygons.Descriptor();
+			return CGAL_SUCCESS;
+		}
+		catch (...)
+		{
+			offsetPolygons.Clear();
+			offsetIndices.clear();
+			descriptor = offsetPolygons.Descriptor();
+			return CGAL_ERROR;
+		}
+	}
+
+	//Copies out the offset polygons with the index of the distance each is for.
+	CGALWRAPPERAPI void CALLCON Skeleton2_GetOffsets2f(Point2f* outPoints, int* outRingSizes, int* outPolygonRings, int* outOffsetIndices)
+	{
+		offsetPolygons.CopyTo(outPoints, outRingSizes, outPolygonRings);
+
+		if (outOffsetIndices != nullptr)
+			std::copy(offsetIndices.begin(), offsetIndices.end(), outOffsetIndices);
+	}
+
+	//Creates the skeleton of each polygon with holes in the flat buffer layout on
+	//a worker thread. Each polygon's skeleton keeps its own indices. A polygon
+	//whose skeleton fails is left empty.
+	CGALWRAPPERAPI CGALResult CALLCON Skeleton2_BatchSkeleton2f(const Point2f* inPoints, const int* inRingSizes, const int* inPolygonRings, int numPolygons, BOOL exterior, double maxOffset, BOOL includeBorder, MeshDescriptor& descriptor)
+	{
+		try
+		{
+			skeleton.Clear();
+			vertexOffsets.clear();
+			edgeOffsets.clear();
+			connectionOffsets.clear();
+
+			PolygonBuffer2f input;
+			input.Load(inPoints, inRingSizes, inPolygonRings, numPolygons);
+
+			vector<SkeletonBuffer> results(input.NumPolygons());
+
+			Utility::ParallelFor(input.NumPolygons(), [&](int i)
+			{
+				try
+				{
+					PolygonWithHoles pwh = input.ToPolygon<PolygonWithHoles>(i);
+					Skeletons s;
+
+					if (exterior)
+					{
+						s.Exterior(pwh, maxOffset, false);
+						ConvertExterior(s, includeBorder, results[i]);
+					}
+					else
+						ConvertFromHalfEdge(s.Interior(pwh), includeBorder, results[i]);
+				}
+				catch (...)
+				{
+					results[i].Clear();
+				}
+			});
+
+			for (auto& result : results)
+			{
+				vertexOffsets.push_back(int(skeleton.points.size()));
+				edgeOffsets.push_back(int(skeleton.edges.size()));
+				connectionOffsets.push_back(int(skeleton.edgeConnections.size()));
+				skeleton.Append(result);
+			}
+
+			vertexOffsets.push_back(int(skeleton.points.size()));
+			edgeOffsets.push_back(int(skeleton.edges.size()));
+			connectionOffsets.push_back(int(skeleton.edgeConnections.size()));
+
+			descriptor = skeleton.Descriptor();
+			return CGAL_SUCCESS;
+		}
+		catch (...)
+		{
+			skeleton.Clear();
+			descriptor = skeleton.Descriptor();
+			return CGAL_ERROR;
+		}
+	}
+
+	//Where each polygon's vertices, edges and connections start, plus the totals.
+	CGALWRAPPERAPI void CALLCON Skeleton2_GetBatchSkeletonOffsets(int* outVertexOffsets, int* outEdgeOffsets, int* outConnectionOffsets)
+	{
+		if (outVertexOffsets != nullptr)
+			std::copy(vertexOffsets.begin(), vertexOffsets.end(), outVertexOffsets);
+
+		if (outEdgeOffsets != nullptr)
+			std::copy(edgeOffsets.begin(), edgeOffsets.end(), outEdgeOffsets);
+
+		if (outConnectionOffsets != nullptr)
+			std::copy(connectionOffsets.begin(), connectionOffsets.end(), outConnectionOffsets);
+	}
+
+	//Creates the offset polygons for every distance of each polygon with holes
+	//on a worker thread, building the polygon's skeletons once. A polygon whose
+	//skeleton fails has no offsets.
+	CGALWRAPPERAPI CGALResult CALLCON Skeleton2_BatchOffsets2f(const Point2f* inPoints, const int* inRingSizes, const int* inPolygonRings, int numPolygons, const double* inOffsets, int numOffsets, BOOL exterior, PolygonBufferDescriptor& descriptor)
+	{
+		try
+		{
+			offsetPolygons.Clear();
+			offsetIndices.clear();
+			sourceOffsets.clear();
+
+			PolygonBuffer2f input;
+			input.Load(inPoints, inRingSizes, inPolygonRings, numPolygons);
+
+			double maxOffset = 0;
+			for (int i = 0; i < numOffsets; i++)
+				maxOffset = (std::max)(maxOffset, inOffsets[i]);
+
+			vector<PolygonBuffer2f> results(input.NumPolygons());
+			vector<vector<int>> indices(input.NumPolygons());
+
+			Utility::ParallelFor(input.NumPolygons(), [&](int i)
+			{
+				try
+				{
+					PolygonWithHoles pwh = input.ToPolygon<PolygonWithHoles>(i);
+					Skeletons s;
+
+					if (exterior)
+						s.Exterior(pwh, maxOffset, false);
+					else
+						s.Interior(pwh);
+
+					for (int j = 0; j < numOffsets; j++)
+					{
+						PolygonWithHolesPtrVector offsets = exterior ? CreateExteriorOffset(s, inOffsets[j]) : CreateOffset(*s.interior, inOffsets[j], false);
+
+						for (auto& offset : offsets)
+						{
+							results[i].AddPolygonWithHoles(*offset);
+							indices[i].push_back(j);
+						}
+					}
+				}
+				catch (...)
+				{
+					results[i].Clear();
+					indices[i].clear();
+				}
+			});
+
+			for (int i = 0; i < input.NumPolygons(); i++)
+			{
+				sourceOffsets.push_back(offsetPolygons.NumPolygons());
+				offsetPolygons.Append(results[i]);
+				offsetIndices.insert(offsetIndices.end(), indices[i].begin(), indices[i].end());
+			}
+
+			sourceOffsets.push_back(offsetPolygons.NumPolygons());
+
+			descriptor = offsetPolygons.Descriptor();
+			return CGAL_SUCCESS;
+		}
+		catch (...)
+		{
+			offsetPolygons.Clear();
+			offsetIndices.clear();
+			sourceOffsets.clear();
+			descriptor = offsetPolygons.Descriptor();
+			return CGAL_ERROR;
+		}
+	}
+
+	//Copies out the offset polygons with the index of the distance each is for
+	//and where each input polygon's offsets start, plus the total.
+	CGALWRAPPERAPI void CALLCON Skeleton2_GetBatchOffsets2f(Point2f* outPoints, int* outRingSizes, int* outPolygonRings, int* outOffsetIndices, int* outPolygonOffsets)
+	{
+		Skeleton2_GetOffsets2f(outPoints, outRingSizes, outPolygonRings, outOffsetIndices);
+
+		if (outPolygonOffsets != nullptr)
+			std::copy(sourceOffsets.begin(), sourceOffsets.end(), outPolygonOffsets);
+	}
+
 }
\ No newline at end of file